@@ -3,6 +3,7 @@
 
 #include <memory>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "Datatype.hpp"
@@ -11,23 +12,195 @@
 using Extent = std::vector< std::uint64_t >;
 using Offset = std::vector< std::uint64_t >;
 
+/** Placement of a chunk inside a larger buffer in memory.
+ *
+ * All quantities are given in elements of the buffer, e.g. an array of structs
+ * holding three components per particle is described by a stride of three.
+ * A default-constructed layout describes a dense buffer matching the extent of the chunk.
+ */
+struct MemoryLayout
+{
+    MemoryLayout() = default;
+    /**
+     * @param   shape   Extent of the whole buffer.
+     * @param   offset  Position of the first element of the chunk inside the buffer.
+     * @param   stride  Distance between neighbouring elements of the chunk per dimension, empty for a distance of one.
+     */
+    MemoryLayout(Extent shape, Offset offset, Extent stride = {});
+
+    /**
+     * @return  Whether the layout describes a dense buffer matching the extent of the chunk.
+     */
+    bool dense() const { return shape.empty(); }
+
+    Extent shape;
+    Offset offset;
+    Extent stride;
+};
+
 class Dataset
 {
     friend class RecordComponent;
 
 public:
+    /** Filter applied to the stored chunks of a dataset, e.g. for checksums or compression.
+     *
+     * Filters are identified by the ID registered for them with The HDF Group.
+     * Filters that are not built into the backend are loaded from plugins at runtime,
+     * e.g. from the directories listed in <code>HDF5_PLUGIN_PATH</code>.
+     */
+    struct Filter
+    {
+        /**
+         * @param   id_         Registered ID of the filter.
+         * @param   parameters_ Filter-specific parameters.
+         * @param   optional_   Whether data is stored unfiltered if the filter is unavailable or fails instead of raising an error.
+         */
+        Filter(unsigned int id_, std::vector< unsigned int > parameters_ = {}, bool optional_ = false)
+                : id{id_},
+                  parameters{std::move(parameters_)},
+                  optional{optional_}
+        { }
+
+        /** Reorder the bytes of all elements to group bytes of equal significance. */
+        static Filter shuffle();
+        /** Store a Fletcher32 checksum with each chunk. */
+        static Filter fletcher32();
+        /** Compress with deflate (zlib), level 0 to 9. */
+        static Filter deflate(unsigned int level);
+        /** Compress with szip, nearest neighbour or entropy coding with an even number of pixels per block up to 32. */
+        static Filter szip(unsigned int pixelsPerBlock = 16, bool nearestNeighbour = true);
+        /** Reorder the bits of all elements, optionally followed by LZ4 compression (plugin). */
+        static Filter bitshuffle(bool lz4 = true, unsigned int blockSize = 0);
+        /** Compress with LZ4 (plugin), a block size of 0 selects the default. */
+        static Filter lz4(unsigned int blockSize = 0);
+        /** Compress with Zstandard (plugin). */
+        static Filter zstd(int level = 3);
+        /** Compress with Blosc (plugin), the compressor is selected by its Blosc code (0 for blosclz, 1 for lz4, 5 for zstd). */
+        static Filter blosc(unsigned int level = 5, bool shuffle = true, unsigned int compressor = 0);
+
+        bool operator==(Filter const&) const;
+
+        unsigned int id;
+        std::vector< unsigned int > parameters;
+        bool optional;
+    };
+
+    /** Access pattern the automatically chosen storage chunks of a dataset are shaped for.
+     */
+    enum class ChunkAccess
+    {
+        FULL,   //!< whole dataset or blocks spanning all dimensions, chunks are shaped evenly
+        SLICE   //!< slices along the first (slowest varying) dimension, chunks are kept thin in that dimension
+    };
+
+    /** How the elements of a dataset are arranged in storage.
+     */
+    enum class Layout
+    {
+        DEFAULT,    //!< contiguous for datasets without filters or chunk settings, chunked otherwise
+        CONTIGUOUS, //!< a single block of fixed extent, can not be extended or filtered
+        COMPACT,    //!< stored with the metadata of the dataset, limited to MAX_COMPACT_BYTES and a fixed extent
+        CHUNKED     //!< blocks of chunkSize each, required for extending and filtering the dataset
+    };
+
+    /** When the fill value is written to the storage allocated for a dataset.
+     */
+    enum class FillTime
+    {
+        DEFAULT,    //!< only if a fill value has been defined (the default)
+        ALWAYS,     //!< always, so unwritten elements read as zero
+        NEVER       //!< never, unwritten elements hold arbitrary values
+    };
+
+    /** When storage is allocated for a dataset.
+     */
+    enum class AllocationTime
+    {
+        DEFAULT,        //!< backend default, i.e. incrementally for chunked datasets
+        EARLY,          //!< all at once when the dataset is created
+        INCREMENTAL,    //!< for each chunk when it is first written
+        LATE            //!< all at once when the dataset is first written
+    };
+
+    /** Maximum size of a dataset with Layout::COMPACT in bytes, as metadata blocks are limited to 64 KiB. */
+    static constexpr size_t MAX_COMPACT_BYTES = 64000;
+    /** Default upper bound for the size of automatically chosen storage chunks in bytes. */
+    static constexpr size_t DEFAULT_CHUNK_BYTES = 1024 * 1024;
+
     Dataset(Datatype, Extent);
 
     Dataset& extend(Extent newExtent);
+    /** Choose how the elements of the dataset are arranged in storage.
+     *
+     * Contiguous and compact datasets avoid the indexing overhead of chunks, but their extent is final.
+     *
+     * @param   layout  Layout of the dataset.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setLayout(Layout layout);
+    /**
+     * @throw   std::runtime_error  If chunks, filters or compression are requested for a layout other than Layout::CHUNKED,
+     *                              or if the dataset is too large for Layout::COMPACT.
+     * @return  Layout the dataset is created with, i.e. layout with Layout::DEFAULT resolved.
+     */
+    Layout resolvedLayout() const;
+    /** Set the extent of the storage chunks and switch the dataset to a chunked layout.
+     */
     Dataset& setChunkSize(std::vector< size_t > const&);
+    /** Choose the shape of the storage chunks when the dataset is created (the default).
+     *
+     * The shape is derived from the datatype and the extent at the time of creation
+     * and reported back through RecordComponent::getChunkSize() to writers and readers.
+     * The dataset is switched to a chunked layout.
+     *
+     * @param   targetBytes Upper bound for the size of a single chunk in bytes. A divisor of
+     *                      the stripe size of the file system keeps chunks from straddling stripes.
+     * @param   access      Access pattern the chunks are shaped for.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setAutomaticChunking(size_t targetBytes = DEFAULT_CHUNK_BYTES, ChunkAccess access = ChunkAccess::FULL);
+    /**
+     * @return  Storage chunk shape the automatic chunking policy chooses for the current datatype and extent.
+     */
+    Extent automaticChunkSize() const;
+    /** Choose when the fill value is written to newly allocated storage.
+     *
+     * Skipping the fill value saves writing storage that is about to be overwritten anyway.
+     *
+     * @param   fillTime    Time to write the fill value at.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setFillTime(FillTime fillTime);
+    /** Choose when storage is allocated for the dataset.
+     *
+     * @param   allocationTime  Time to allocate storage at.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& setAllocationTime(AllocationTime allocationTime);
     Dataset& setCompression(std::string const&, uint8_t const);
     Dataset& setCustomTransform(std::string const&);
+    /** Append a filter to the pipeline applied to the stored chunks.
+     *
+     * Filters are applied in the order they were added when writing and in reverse order when reading.
+     * The pipeline is stored with the dataset and restored when the dataset is read.
+     *
+     * @param   filter  Filter to append.
+     * @return  Reference to modified dataset.
+     */
+    Dataset& addFilter(Filter filter);
 
     Extent extent;
     Datatype dtype;
     uint8_t rank;
-    Extent chunkSize;
+    Layout layout;
+    Extent chunkSize;   /* empty to choose the shape when the dataset is created */
+    size_t chunkBytes;
+    ChunkAccess chunkAccess;
+    FillTime fillTime;
+    AllocationTime allocationTime;
     std::string compression;
     std::string transform;
+    std::vector< Filter > filters;
 };
 
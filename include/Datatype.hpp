@@ -1,6 +1,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 #include <cstdint>
 #include <iosfwd>
 #include <memory>
@@ -38,6 +39,48 @@ enum class Datatype : int
     UNDEFINED
 };  //Datatype
 
+/** Whether a datatype holds single integer or floating point values.
+ *
+ * Values of numeric datatypes can be converted into each other during dataset IO.
+ */
+inline bool
+isNumeric(Datatype d)
+{
+    return Datatype::CHAR <= d && d <= Datatype::LONG_DOUBLE;
+}
+
+/** Size of a single value of a datatype.
+ *
+ * @return  Size in bytes for numeric datatypes and BOOL, 0 for all other datatypes.
+ */
+inline size_t
+toBytes(Datatype d)
+{
+    using DT = Datatype;
+    switch( d )
+    {
+        case DT::CHAR:
+        case DT::UCHAR:
+        case DT::BOOL:
+            return 1;
+        case DT::INT16:
+        case DT::UINT16:
+            return 2;
+        case DT::INT32:
+        case DT::UINT32:
+        case DT::FLOAT:
+            return 4;
+        case DT::INT64:
+        case DT::UINT64:
+        case DT::DOUBLE:
+            return 8;
+        case DT::LONG_DOUBLE:
+            return sizeof(long double);
+        default:
+            return 0;
+    }
+}
+
 /** @brief Fundamental equivalence check for two given types T and U.
  *
  * This checks whether the fundamental datatype (i.e. that of a single value
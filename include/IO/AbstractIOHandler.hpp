@@ -24,8 +24,11 @@
 #include <exception>
 #include <future>
 #include <queue>
+#include <set>
 
+#include "auxiliary/StagingBufferPool.hpp"
 #include "AccessType.hpp"
+#include "FileTuning.hpp"
 #include "Format.hpp"
 #include "IOTask.hpp"
 
@@ -54,6 +57,8 @@ public:
     virtual ~unsupported_data_error() { }
 };
 
+class RecordComponent;
+
 
 /** Interface for communicating between logical and physically persistent data.
  *
@@ -71,11 +76,13 @@ public:
      * @param   path        Path to root folder for all operations associated with the desired handler.
      * @param   accessType  AccessType describing desired operations and permissions of the desired handler.
      * @param   format      Format describing the IO backend of the desired handler.
+     * @param   asynchronous  Flag indicating whether operations should be executed by a dedicated IO thread.
      * @return  Smart pointer to created IOHandler.
      */
     static std::shared_ptr< AbstractIOHandler > createIOHandler(std::string const& path,
                                                                 AccessType accessType,
-                                                                Format format);
+                                                                Format format,
+                                                                bool asynchronous = false);
 
     AbstractIOHandler(std::string const& path, AccessType);
     virtual ~AbstractIOHandler();
@@ -90,10 +97,50 @@ public:
      * @return  Future indicating the completion state of the operation for backends that decide to implement this operation asynchronously.
      */
     virtual std::future< void > flush() = 0;
+    /** Process operations in queue according to FIFO without waiting for their completion.
+     *
+     * Handlers without a dedicated IO thread execute all operations before returning.
+     *
+     * @return  Valid future that becomes ready once all operations enqueued before this call completed.
+     */
+    virtual std::future< void > flushAsynchronously();
+    /** Block until all operations handed to the backend by previous flushes completed.
+     */
+    virtual void wait();
+    /** Limit the number of files kept open simultaneously.
+     *
+     * Files exceeding the limit are closed in least-recently-used order and re-opened transparently on their next access.
+     * Handlers that do not pool their files ignore the limit.
+     *
+     * @param   maxOpenFiles    Maximum number of open files, 0 for no limit.
+     */
+    virtual void setMaxOpenFiles(size_t maxOpenFiles);
+    /** Filter chunks of filtered datasets on multiple threads instead of inside the backend library.
+     *
+     * Handlers without support for this ignore the setting.
+     *
+     * @param   numThreads  Number of threads to filter chunks on, 0 to leave filtering to the backend library.
+     */
+    virtual void setCompressionThreads(unsigned int numThreads);
+    /** Tune the files created or opened from now on.
+     *
+     * Handlers ignore settings they do not support.
+     *
+     * @param   tuning  Settings to apply.
+     */
+    virtual void setFileTuning(FileTuning const& tuning);
 
     std::string const directory;
     AccessType const accessType;
     std::queue< IOTask > m_work;
+    /** Buffers that stored chunks are copied into, empty if chunks reference the memory of the caller. */
+    std::shared_ptr< StagingBufferPool > stagingBuffers;
+    /** Size of all stored chunks that have not been handed to the backend yet in bytes. */
+    size_t pendingBytes;
+    /** Components holding the chunks that count towards pendingBytes. */
+    std::set< RecordComponent* > pendingComponents;
+    /** Size of pending chunks beyond which the series is flushed automatically in bytes, 0 for no limit. */
+    size_t maxPendingBytes;
 };  //AbstractIOHandler
 
 
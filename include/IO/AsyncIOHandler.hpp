@@ -0,0 +1,102 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of libopenPMD.
+ *
+ * libopenPMD is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libopenPMD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libopenPMD.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#pragma once
+
+
+#include <condition_variable>
+#include <deque>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+
+#include "AbstractIOHandler.hpp"
+
+
+/** Handler executing the writes of dataset contents of another handler on a dedicated IO thread.
+ *
+ * Operations are collected in this handlers queue and handed to the backend
+ * once per flush. All operations but WRITE_DATASET are executed by the flushing
+ * thread, so only it modifies the Writables of the frontend (e.g. their written
+ * state and file position). The WRITE_DATASET operations of a flush are handed
+ * to a single worker thread as one batch, batches are processed in the order
+ * they were submitted. The backend is never accessed concurrently, as every
+ * flush waits for the worker to become idle first.
+ * While the future of a flush is pending, the buffers of its chunks must stay
+ * unmodified and the written RecordComponents must not be reset, made constant
+ * or destroyed.
+ */
+class AsyncIOHandler : public AbstractIOHandler
+{
+public:
+    /** Construct a handler forwarding all operations to a backend.
+     *
+     * @param   backend Handler that is exclusively accessed from the IO thread after construction.
+     */
+    AsyncIOHandler(std::shared_ptr< AbstractIOHandler > backend);
+    /** Complete all pending operations and terminate the IO thread.
+     */
+    ~AsyncIOHandler();
+
+    /** Hand all operations in queue to the IO thread and block until they completed.
+     *
+     * @return  Ready future.
+     */
+    std::future< void > flush() override;
+    /** Execute all operations in queue but the writes of dataset contents, which are handed to the IO thread.
+     *
+     * Blocks until previous writes completed.
+     *
+     * @return  Future that becomes ready once the operations completed, holding exceptions thrown by the backend.
+     */
+    std::future< void > flushAsynchronously() override;
+    void wait() override;
+    /** Forward the limit to the backend once all pending operations completed.
+     */
+    void setMaxOpenFiles(size_t maxOpenFiles) override;
+    void setCompressionThreads(unsigned int numThreads) override;
+    void setFileTuning(FileTuning const& tuning) override;
+
+private:
+    struct Batch
+    {
+        std::queue< IOTask > work;
+        std::promise< void > done;
+    };
+
+    void submit(Batch);
+    /** Block until the IO thread is idle.
+     *
+     * @return  Lock on the state of the IO thread, it stays idle while the lock is held.
+     */
+    std::unique_lock< std::mutex > waitIdle();
+    void run();
+
+    std::shared_ptr< AbstractIOHandler > m_backend;
+    std::deque< Batch > m_batches;
+    bool m_busy;
+    bool m_shutdown;
+    std::mutex m_mutex;
+    std::condition_variable m_submitted;
+    std::condition_variable m_completed;
+    std::thread m_worker;
+};  //AsyncIOHandler
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+
+/** Low-level tuning of the files created and opened by a backend.
+ *
+ * All settings default to the behaviour of the backend library.
+ * Backends ignore settings they do not support.
+ */
+struct FileTuning
+{
+    /** Oldest version of the file format objects are written in.
+     *
+     * Newer versions allow more efficient structures, but can not be read by older library versions.
+     */
+    enum class FormatVersion
+    {
+        EARLIEST,   //!< most compatible format (the default)
+        V18,        //!< readable by HDF5 1.8 and later
+        V110,       //!< readable by HDF5 1.10 and later
+        LATEST      //!< newest format of the library in use
+    };
+
+    /** Align objects of at least alignmentThreshold bytes to multiples of this many bytes, 1 for no alignment.
+     *
+     * Aligning to the stripe size of a parallel file system avoids writes spanning stripe boundaries.
+     */
+    uint64_t alignment = 1;
+    /** Minimum size of objects to align in bytes. */
+    uint64_t alignmentThreshold = 1;
+    /** Size of the blocks metadata is aggregated in before it is written, 0 for the library default. */
+    uint64_t metaBlockSize = 0;
+    /** Size of the pages file space is aggregated in when creating files, 0 to not use paged aggregation. */
+    uint64_t pageSize = 0;
+    /** Size of the metadata cache of each open file in bytes, 0 for the library default. */
+    size_t metadataCacheSize = 0;
+    FormatVersion formatVersion = FormatVersion::EARLIEST;
+};  //FileTuning
@@ -1,11 +1,13 @@
 #pragma once
 
+#include <algorithm>
 #include <stack>
 
 #include <hdf5.h>
 
 #include "backend/Attribute.hpp"
 #include "auxiliary/StringManip.hpp"
+#include "Dataset.hpp"
 #include "HDF5FilePosition.hpp"
 #include "backend/Writable.hpp"
 
@@ -194,6 +196,66 @@ getH5DataSpace(Attribute const& att)
     }
 }
 
+/** Create the dataspace describing a chunk in memory.
+ *
+ * @param   extent  Extent of the chunk.
+ * @param   layout  Placement of the chunk inside its buffer, dense layouts select the whole dataspace.
+ * @return  Dataspace that has to be H5Sclose()'d by the caller.
+ */
+inline hid_t
+getH5MemorySpace(Extent const& extent, MemoryLayout const& layout)
+{
+    std::vector< hsize_t > block(extent.begin(), extent.end());
+    if( layout.dense() )
+        return H5Screate_simple(block.size(), block.data(), nullptr);
+
+    std::vector< hsize_t > shape(layout.shape.begin(), layout.shape.end());
+    std::vector< hsize_t > start(layout.offset.begin(), layout.offset.end());
+    std::vector< hsize_t > stride(layout.stride.begin(), layout.stride.end());
+    hid_t memspace = H5Screate_simple(shape.size(), shape.data(), nullptr);
+    /* strided elements are selected as a regular pattern of single-element blocks */
+    std::vector< hsize_t > count(block);
+    std::fill(block.begin(), block.end(), 1);
+    H5Sselect_hyperslab(memspace,
+                        H5S_SELECT_SET,
+                        start.data(),
+                        stride.data(),
+                        count.data(),
+                        block.data());
+    return memspace;
+}
+
+/** Read the filter pipeline from a dataset creation property list.
+ *
+ * @param   datasetCreationProperty Property list as returned by H5Dget_create_plist().
+ * @return  Filters in the order they are applied when writing.
+ */
+inline std::vector< Dataset::Filter >
+getH5Filters(hid_t datasetCreationProperty)
+{
+    std::vector< Dataset::Filter > filters;
+    int const numFilters = H5Pget_nfilters(datasetCreationProperty);
+    for( int i = 0; i < numFilters; ++i )
+    {
+        unsigned int flags = 0;
+        size_t numParameters = 16;
+        std::vector< unsigned int > parameters(numParameters);
+        H5Z_filter_t id = H5Pget_filter2(datasetCreationProperty,
+                                         static_cast< unsigned int >(i),
+                                         &flags,
+                                         &numParameters,
+                                         parameters.data(),
+                                         0,
+                                         nullptr,
+                                         nullptr);
+        parameters.resize(std::min(numParameters, parameters.size()));
+        filters.emplace_back(static_cast< unsigned int >(id),
+                             parameters,
+                             (flags & H5Z_FLAG_OPTIONAL) != 0);
+    }
+    return filters;
+}
+
 inline std::string
 concrete_h5_file_position(Writable* w)
 {
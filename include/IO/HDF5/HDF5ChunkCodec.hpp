@@ -0,0 +1,313 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include <hdf5.h>
+#if defined(LIBOPENPMD_WITH_ZLIB)
+#   include <zlib.h>
+#endif
+
+#include "Dataset.hpp"
+#include "HDF5Auxiliary.hpp"
+
+
+/** Storage chunks of a dataset that a hyperslab is composed of.
+ *
+ * Describes hyperslabs whose chunks can be filtered outside of the HDF5
+ * library and transferred with direct chunk IO.
+ */
+struct H5DirectChunkPlan
+{
+    std::vector< Dataset::Filter > filters; /* in the order they are applied when writing */
+    Extent chunk;               /* extent of a storage chunk */
+    Extent dims;                /* extent of the dataset */
+    size_t elementSize;
+    std::vector< Offset > origins; /* first element of all chunks covering the hyperslab */
+
+    /** @return Size of a complete storage chunk before filtering in bytes. */
+    size_t chunkBytes() const
+    {
+        size_t bytes = elementSize;
+        for( auto const& c : chunk )
+            bytes *= c;
+        return bytes;
+    }
+
+    /** @return Extent of the part of a chunk that lies inside the dataset. */
+    Extent inside(Offset const& origin) const
+    {
+        Extent e(chunk.size());
+        for( size_t k = 0; k < chunk.size(); ++k )
+            e[k] = std::min(chunk[k], dims[k] - origin[k]);
+        return e;
+    }
+};  //H5DirectChunkPlan
+
+/** @return Whether a filter can be applied and reverted outside of the HDF5 library. */
+inline bool
+canFilterDirectly(Dataset::Filter const& filter)
+{
+    switch( filter.id )
+    {
+        case H5Z_FILTER_SHUFFLE:
+        case H5Z_FILTER_FLETCHER32:
+            return true;
+#if defined(LIBOPENPMD_WITH_ZLIB)
+        case H5Z_FILTER_DEFLATE:
+            return !filter.parameters.empty();
+#endif
+        default:
+            return false;
+    }
+}
+
+/** Determine the storage chunks a hyperslab of a dataset consists of.
+ *
+ * Only hyperslabs that are composed of whole storage chunks (clipped at the
+ * boundary of the dataset) of a filtered dataset qualify, and only if all of
+ * its filters can be applied outside of HDF5 and no datatype conversion is required.
+ *
+ * @param   dataset Open dataset.
+ * @param   memType Datatype of the elements in memory.
+ * @param   offset  Offset of the hyperslab.
+ * @param   extent  Extent of the hyperslab.
+ * @param   plan    Receives the chunks of the hyperslab.
+ * @return  Whether the hyperslab qualifies for direct chunk IO.
+ */
+inline bool
+planDirectChunks(hid_t dataset, hid_t memType, Offset const& offset, Extent const& extent, H5DirectChunkPlan& plan)
+{
+    size_t const rank = extent.size();
+    if( rank == 0 )
+        return false;
+    for( auto const& e : extent )
+        if( e == 0 )
+            return false;
+
+    hid_t fileType = H5Dget_type(dataset);
+    bool const sameType = H5Tequal(fileType, memType) > 0;
+    plan.elementSize = H5Tget_size(fileType);
+    H5Tclose(fileType);
+    if( !sameType )
+        return false;
+
+    hid_t datasetCreationProperty = H5Dget_create_plist(dataset);
+    bool chunked = H5Pget_layout(datasetCreationProperty) == H5D_CHUNKED;
+    std::vector< hsize_t > chunk(rank);
+    if( chunked )
+        chunked = H5Pget_chunk(datasetCreationProperty, static_cast< int >(rank), chunk.data()) == static_cast< int >(rank);
+    plan.filters = getH5Filters(datasetCreationProperty);
+    H5Pclose(datasetCreationProperty);
+    if( !chunked || plan.filters.empty() )
+        return false;
+    for( auto const& filter : plan.filters )
+        if( !canFilterDirectly(filter) )
+            return false;
+
+    hid_t space = H5Dget_space(dataset);
+    std::vector< hsize_t > dims(rank);
+    bool const sameRank = H5Sget_simple_extent_ndims(space) == static_cast< int >(rank);
+    if( sameRank )
+        H5Sget_simple_extent_dims(space, dims.data(), nullptr);
+    H5Sclose(space);
+    if( !sameRank )
+        return false;
+
+    plan.chunk.assign(chunk.begin(), chunk.end());
+    plan.dims.assign(dims.begin(), dims.end());
+    for( size_t k = 0; k < rank; ++k )
+    {
+        uint64_t const end = offset[k] + extent[k];
+        if( offset[k] % plan.chunk[k] != 0 || (end % plan.chunk[k] != 0 && end != plan.dims[k]) )
+            return false;
+    }
+
+    plan.origins.clear();
+    Offset origin(offset);
+    while( true )
+    {
+        plan.origins.push_back(origin);
+        size_t k = rank;
+        while( k-- > 0 )
+        {
+            origin[k] += plan.chunk[k];
+            if( origin[k] < offset[k] + extent[k] )
+                break;
+            origin[k] = offset[k];
+        }
+        if( k >= rank )
+            break;
+    }
+    return true;
+}
+
+/** Fletcher-32 checksum as computed by the HDF5 fletcher32 filter. */
+inline uint32_t
+h5Fletcher32(unsigned char const* data, size_t bytes)
+{
+    uint32_t sum1 = 0;
+    uint32_t sum2 = 0;
+    size_t words = bytes / 2;
+    while( words > 0 )
+    {
+        /* fold before the sums can overflow */
+        size_t block = std::min< size_t >(words, 360);
+        words -= block;
+        for( ; block > 0; --block, data += 2 )
+        {
+            sum1 += (static_cast< uint32_t >(data[0]) << 8) | data[1];
+            sum2 += sum1;
+        }
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+    if( bytes % 2 != 0 )
+    {
+        sum1 += static_cast< uint32_t >(*data) << 8;
+        sum2 += sum1;
+        sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+        sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    }
+    sum1 = (sum1 & 0xffff) + (sum1 >> 16);
+    sum2 = (sum2 & 0xffff) + (sum2 >> 16);
+    return (sum2 << 16) | sum1;
+}
+
+/** Apply a filter pipeline to a chunk, producing the bytes HDF5 stores for it.
+ *
+ * @param   filters Filters in the order they are applied when writing. All of them must satisfy canFilterDirectly().
+ * @param   bytes   Unfiltered chunk, replaced by the filtered chunk.
+ */
+inline void
+encodeChunk(std::vector< Dataset::Filter > const& filters, std::vector< unsigned char >& bytes)
+{
+    std::vector< unsigned char > out;
+    for( auto const& filter : filters )
+    {
+        switch( filter.id )
+        {
+            case H5Z_FILTER_SHUFFLE:
+            {
+                /* transpose the bytes of all elements, a partial trailing element is kept as is */
+                size_t const typeSize = filter.parameters.empty() ? 1 : filter.parameters[0];
+                size_t const numElements = bytes.size() / typeSize;
+                if( typeSize <= 1 || numElements <= 1 )
+                    break;
+                out.resize(bytes.size());
+                for( size_t b = 0; b < typeSize; ++b )
+                    for( size_t i = 0; i < numElements; ++i )
+                        out[b * numElements + i] = bytes[i * typeSize + b];
+                std::copy(bytes.begin() + numElements * typeSize, bytes.end(), out.begin() + numElements * typeSize);
+                bytes.swap(out);
+                break;
+            }
+            case H5Z_FILTER_FLETCHER32:
+            {
+                uint32_t const checksum = h5Fletcher32(bytes.data(), bytes.size());
+                for( int i = 0; i < 4; ++i )
+                    bytes.push_back(static_cast< unsigned char >(checksum >> (8 * i)));
+                break;
+            }
+#if defined(LIBOPENPMD_WITH_ZLIB)
+            case H5Z_FILTER_DEFLATE:
+            {
+                uLongf size = compressBound(static_cast< uLong >(bytes.size()));
+                out.resize(size);
+                int status = compress2(out.data(),
+                                       &size,
+                                       bytes.data(),
+                                       static_cast< uLong >(bytes.size()),
+                                       static_cast< int >(filter.parameters[0]));
+                if( status != Z_OK )
+                    throw std::runtime_error("Failed to deflate HDF5 chunk");
+                out.resize(size);
+                bytes.swap(out);
+                break;
+            }
+#endif
+            default:
+                throw std::runtime_error("HDF5 filter " + std::to_string(filter.id) + " can not be applied outside of HDF5");
+        }
+    }
+}
+
+/** Revert a filter pipeline on a chunk as stored by HDF5.
+ *
+ * @param   filters     Filters in the order they are applied when writing. All of them must satisfy canFilterDirectly().
+ * @param   filterMask  Mask returned by HDF5 for the chunk, set bits mark filters that were skipped when writing it.
+ * @param   bytes       Filtered chunk, replaced by the unfiltered chunk.
+ * @param   chunkBytes  Size of the unfiltered chunk in bytes, used as initial guess for decompression.
+ */
+inline void
+decodeChunk(std::vector< Dataset::Filter > const& filters,
+            uint32_t filterMask,
+            std::vector< unsigned char >& bytes,
+            size_t chunkBytes)
+{
+    std::vector< unsigned char > out;
+    for( size_t f = filters.size(); f-- > 0; )
+    {
+        if( filterMask & (1u << f) )
+            continue;
+
+        Dataset::Filter const& filter = filters[f];
+        switch( filter.id )
+        {
+            case H5Z_FILTER_SHUFFLE:
+            {
+                size_t const typeSize = filter.parameters.empty() ? 1 : filter.parameters[0];
+                size_t const numElements = bytes.size() / typeSize;
+                if( typeSize <= 1 || numElements <= 1 )
+                    break;
+                out.resize(bytes.size());
+                for( size_t b = 0; b < typeSize; ++b )
+                    for( size_t i = 0; i < numElements; ++i )
+                        out[i * typeSize + b] = bytes[b * numElements + i];
+                std::copy(bytes.begin() + numElements * typeSize, bytes.end(), out.begin() + numElements * typeSize);
+                bytes.swap(out);
+                break;
+            }
+            case H5Z_FILTER_FLETCHER32:
+            {
+                if( bytes.size() < 4 )
+                    throw std::runtime_error("Truncated HDF5 chunk");
+                size_t const size = bytes.size() - 4;
+                uint32_t stored = 0;
+                for( int i = 0; i < 4; ++i )
+                    stored |= static_cast< uint32_t >(bytes[size + i]) << (8 * i);
+                if( stored != h5Fletcher32(bytes.data(), size) )
+                    throw std::runtime_error("Checksum mismatch in HDF5 chunk");
+                bytes.resize(size);
+                break;
+            }
+#if defined(LIBOPENPMD_WITH_ZLIB)
+            case H5Z_FILTER_DEFLATE:
+            {
+                /* earlier filters may have grown the chunk, so retry with larger buffers */
+                size_t capacity = std::max< size_t >(chunkBytes, 1);
+                int status;
+                uLongf size;
+                do
+                {
+                    out.resize(capacity);
+                    size = static_cast< uLongf >(capacity);
+                    status = uncompress(out.data(), &size, bytes.data(), static_cast< uLong >(bytes.size()));
+                    capacity *= 2;
+                } while( status == Z_BUF_ERROR );
+                if( status != Z_OK )
+                    throw std::runtime_error("Failed to inflate HDF5 chunk");
+                out.resize(size);
+                bytes.swap(out);
+                break;
+            }
+#endif
+            default:
+                throw std::runtime_error("HDF5 filter " + std::to_string(filter.id) + " can not be reverted outside of HDF5");
+        }
+    }
+}
@@ -6,11 +6,17 @@
 #include <IO/AbstractIOHandler.hpp>
 
 #ifdef LIBOPENPMD_WITH_HDF5
+#include <list>
+#include <map>
+#include <string>
 #include <unordered_map>
-#include <unordered_set>
+#include <utility>
+#include <vector>
 
 #include <hdf5.h>
 
+#include <auxiliary/WorkerPool.hpp>
+
 class HDF5IOHandler;
 
 class HDF5IOHandlerImpl
@@ -20,29 +26,115 @@ public:
     virtual ~HDF5IOHandlerImpl();
 
     virtual std::future< void > flush();
-
-    using ArgumentMap = std::map< std::string, ParameterArgument >;
-    virtual void createFile(Writable*, ArgumentMap const&);
-    virtual void createPath(Writable*, ArgumentMap const&);
-    virtual void createDataset(Writable*, ArgumentMap const&);
-    virtual void extendDataset(Writable*, ArgumentMap const&);
-    virtual void openFile(Writable*, ArgumentMap const&);
-    virtual void openPath(Writable*, ArgumentMap const&);
-    virtual void openDataset(Writable*, ArgumentMap &);
-    virtual void deleteFile(Writable*, ArgumentMap const&);
-    virtual void deletePath(Writable*, ArgumentMap const&);
-    virtual void deleteDataset(Writable*, ArgumentMap const&);
-    virtual void deleteAttribute(Writable*, ArgumentMap const&);
-    virtual void writeDataset(Writable*, ArgumentMap const&);
-    virtual void writeAttribute(Writable*, ArgumentMap const&);
-    virtual void readDataset(Writable*, ArgumentMap &);
-    virtual void readAttribute(Writable*, ArgumentMap &);
-    virtual void listPaths(Writable*, ArgumentMap &);
-    virtual void listDatasets(Writable*, ArgumentMap &);
-    virtual void listAttributes(Writable*, ArgumentMap &);
-
-    std::unordered_map< Writable*, hid_t > m_fileIDs;
-    std::unordered_set< hid_t > m_openFileIDs;
+    /** Merge consecutive WRITE_DATASET operations on the same dataset into a single operation.
+     *
+     * Chunks are merged as long as their hyperslabs touch or overlap such that their union is
+     * again a hyperslab of at most MAX_COALESCED_BYTES. Overlapping chunks are staged in
+     * order of submission, so later chunks take precedence.
+     */
+    void coalesceWrites();
+
+    /** Resolve the path of the HDF5 object a Writable resides in.
+     *
+     * Resolved paths are cached until the end of the flush or until the file position of the Writable changes.
+     */
+    std::string const& position(Writable*);
+    /** Drop the cached paths of a deleted Writable and all of its descendants.
+     */
+    void forgetPositions(Writable*);
+    /** Open the group or dataset a Writable resides in.
+     *
+     * Handles are kept open in a least-recently-used cache of MAX_CACHED_HANDLES entries
+     * and are owned by the cache, i.e. they must not be closed by the caller.
+     *
+     * @param   file    Index of the file in m_files.
+     * @return  Handle of the object or a negative value on failure.
+     */
+    hid_t openObject(size_t file, Writable*);
+    /** Close all cached handles of objects at or below a path in a file.
+     */
+    void closeObjects(size_t file, std::string const& path);
+
+    /** Look up the index of a file in m_files, registering the file if it is not known yet.
+     *
+     * Indices remain valid when the file is closed and re-opened.
+     */
+    size_t fileIndex(std::string const& name);
+    /** Obtain the handle of a file, re-opening the file if it has been closed.
+     *
+     * Open files are kept in a least-recently-used pool of at most m_maxOpenFiles entries.
+     * Evicted files are re-opened transparently on their next access.
+     *
+     * @throw   no_such_file_error  If the file can not be (re-)opened.
+     */
+    hid_t file(size_t index);
+    /** Create the property list to open or create files with according to m_fileTuning.
+     *
+     * @return  Property list that has to be H5Pclose()'d by the caller.
+     */
+    hid_t fileAccessProperty();
+    /** Create the property list to create files with according to m_fileTuning.
+     *
+     * @return  Property list that has to be H5Pclose()'d by the caller.
+     */
+    hid_t fileCreationProperty();
+    /** Mark a file as most recently used and evict files exceeding m_maxOpenFiles. */
+    void useFile(size_t index);
+    /** Close the handle of a file and all cached objects in it, if it is open. */
+    void closeFile(size_t index);
+
+    virtual void createFile(Writable*, Parameter< Operation::CREATE_FILE > const&);
+    virtual void createPath(Writable*, Parameter< Operation::CREATE_PATH > const&);
+    virtual void createDataset(Writable*, Parameter< Operation::CREATE_DATASET > const&);
+    virtual void extendDataset(Writable*, Parameter< Operation::EXTEND_DATASET > const&);
+    virtual void openFile(Writable*, Parameter< Operation::OPEN_FILE > const&);
+    virtual void closeFile(Writable*, Parameter< Operation::CLOSE_FILE > const&);
+    virtual void openPath(Writable*, Parameter< Operation::OPEN_PATH > const&);
+    virtual void openDataset(Writable*, Parameter< Operation::OPEN_DATASET > &);
+    virtual void deleteFile(Writable*, Parameter< Operation::DELETE_FILE > const&);
+    virtual void deletePath(Writable*, Parameter< Operation::DELETE_PATH > const&);
+    virtual void deleteDataset(Writable*, Parameter< Operation::DELETE_DATASET > const&);
+    virtual void deleteAttribute(Writable*, Parameter< Operation::DELETE_ATT > const&);
+    virtual void writeDataset(Writable*, Parameter< Operation::WRITE_DATASET > const&);
+    virtual void writeAttribute(Writable*, Parameter< Operation::WRITE_ATT > const&);
+    virtual void readDataset(Writable*, Parameter< Operation::READ_DATASET > &);
+    virtual void readAttribute(Writable*, Parameter< Operation::READ_ATT > &);
+    virtual void listPaths(Writable*, Parameter< Operation::LIST_PATHS > &);
+    virtual void listDatasets(Writable*, Parameter< Operation::LIST_DATASETS > &);
+    virtual void listAttributes(Writable*, Parameter< Operation::LIST_ATTS > &);
+    virtual void readAllAttributes(Writable*, Parameter< Operation::READ_ALL_ATTS > &);
+
+    /** Write a hyperslab by filtering its storage chunks on m_chunkWorkers and handing them to HDF5 as is.
+     *
+     * @return  Whether the hyperslab has been written, false if it does not qualify for direct chunk IO.
+     */
+    bool writeChunksDirectly(hid_t dataset, Parameter< Operation::WRITE_DATASET > const&);
+    /** Read a hyperslab by reading its storage chunks as stored and reverting their filters on m_chunkWorkers.
+     *
+     * @return  Whether the hyperslab has been read, false if it does not qualify for direct chunk IO.
+     */
+    bool readChunksDirectly(hid_t dataset, Parameter< Operation::READ_DATASET > &);
+
+    /** Decode the value of an opened attribute.
+     *
+     * @throw   unsupported_data_error  If the attribute type has no representation in Datatype.
+     */
+    Attribute readAttributeValue(hid_t attribute, std::string const& name);
+
+    struct File
+    {
+        std::string name;
+        hid_t id; /* negative while the file is closed */
+        std::list< size_t >::iterator use;
+    };
+    std::vector< File > m_files;
+    std::unordered_map< std::string, size_t > m_fileIndices;
+    std::list< size_t > m_fileUsage; /* open files, most recently used first */
+    size_t m_maxOpenFiles; /* 0 for no limit */
+    std::unordered_map< Writable*, size_t > m_fileIDs; /* index into m_files */
+
+    WorkerPool m_chunkWorkers; /* without threads to filter chunks inside the HDF5 library */
+    FileTuning m_fileTuning;
 
     hid_t m_datasetTransferProperty;
     hid_t m_fileAccessProperty;
@@ -50,6 +142,19 @@ public:
     hid_t m_H5T_BOOL_ENUM;
 
     AbstractIOHandler* m_handler;
+
+    using ObjectKey = std::pair< size_t, std::string >;
+    struct CachedObject
+    {
+        hid_t id;
+        std::list< ObjectKey >::iterator use;
+    };
+    std::map< ObjectKey, CachedObject > m_objects;
+    std::list< ObjectKey > m_objectUsage; /* most recently used first */
+    std::unordered_map< Writable*, std::string > m_positions;
+
+    constexpr static size_t MAX_COALESCED_BYTES = 64 * 1024 * 1024;
+    constexpr static size_t MAX_CACHED_HANDLES = 128;
 };  //HDF5IOHandlerImpl
 #else
 class HDF5IOHandlerImpl
@@ -63,6 +168,9 @@ public:
     virtual ~HDF5IOHandler();
 
     std::future< void > flush() override;
+    void setMaxOpenFiles(size_t maxOpenFiles) override;
+    void setCompressionThreads(unsigned int numThreads) override;
+    void setFileTuning(FileTuning const& tuning) override;
 
 private:
     std::unique_ptr< HDF5IOHandlerImpl > m_impl;
@@ -28,6 +28,7 @@ public:
     virtual ~ParallelHDF5IOHandler();
 
     std::future< void > flush() override;
+    void setFileTuning(FileTuning const& tuning) override;
 
 private:
     std::unique_ptr< ParallelHDF5IOHandlerImpl > m_impl;
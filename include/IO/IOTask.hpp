@@ -2,47 +2,21 @@
 
 
 #include <map>
+#include <memory>
+#include <stdexcept>
 
 #include "backend/Attribute.hpp"
 #include "backend/Writable.hpp"
 #include "Dataset.hpp"
 
 
-/** Concrete datatype of an object available at runtime.
- */
-enum class ArgumentDatatype : int
-{
-    STRING = 0,
-    VEC_UINT64,
-    PTR_VOID,
-    SHARED_PTR_VOID,
-    DATATYPE,
-    ATT_RESOURCE,
-    SHARED_PTR_EXTENT,
-    SHARED_PTR_DATATYPE,
-    SHARED_PTR_ATT_RESOURCE,
-    SHARED_PTR_VEC_STRING,
-
-    UNDEFINED
-};
-using ParameterArgument = Variadic< ArgumentDatatype,
-                                    std::string,
-                                    std::vector< uint64_t >,
-                                    void*,
-                                    std::shared_ptr< void >,
-                                    Datatype,
-                                    Attribute::resource,
-                                    std::shared_ptr< Extent >,
-                                    std::shared_ptr< Datatype >,
-                                    std::shared_ptr< Attribute::resource >,
-                                    std::shared_ptr< std::vector< std::string > > >;
-
 /** Type of IO operation between logical and persistent data.
  */
 enum class Operation
 {
     CREATE_FILE,
     OPEN_FILE,
+    CLOSE_FILE,
     DELETE_FILE,
 
     CREATE_PATH,
@@ -61,10 +35,20 @@ enum class Operation
     DELETE_ATT,
     WRITE_ATT,
     READ_ATT,
-    LIST_ATTS
+    LIST_ATTS,
+    READ_ALL_ATTS
 };  //Operation
 
 
+/** Common base of all Parameter objects to store them in a type-erased IOTask.
+ */
+struct AbstractParameter
+{
+    virtual ~AbstractParameter() = default;
+
+    virtual std::unique_ptr< AbstractParameter > clone() const = 0;
+};  //AbstractParameter
+
 /** @brief Typesafe description of all required Arguments for a specified Operation.
  *
  * @note    Input operations (i.e. ones that transfer data from persistent files
@@ -74,119 +58,160 @@ enum class Operation
  * @tparam  Operation   Type of Operation to be executed.
  */
 template< Operation >
-struct Parameter
+struct Parameter : public AbstractParameter
 { };
 
+/** Implements AbstractParameter::clone() once for every Parameter specialization.
+ *
+ * @tparam  op  Operation of the deriving Parameter< op >.
+ */
+template< Operation op >
+struct ClonableParameter : public AbstractParameter
+{
+    std::unique_ptr< AbstractParameter > clone() const override
+    {
+        return std::unique_ptr< AbstractParameter >(new Parameter< op >(static_cast< Parameter< op > const& >(*this)));
+    }
+};
+
 template<>
-struct Parameter< Operation::CREATE_FILE >
+struct Parameter< Operation::CREATE_FILE > : public ClonableParameter< Operation::CREATE_FILE >
 {
     std::string name;
 };
 
 template<>
-struct Parameter< Operation::OPEN_FILE >
+struct Parameter< Operation::OPEN_FILE > : public ClonableParameter< Operation::OPEN_FILE >
 {
     std::string name;
 };
 
 template<>
-struct Parameter< Operation::DELETE_FILE >
+struct Parameter< Operation::CLOSE_FILE > : public ClonableParameter< Operation::CLOSE_FILE >
+{ };
+
+template<>
+struct Parameter< Operation::DELETE_FILE > : public ClonableParameter< Operation::DELETE_FILE >
 {
     std::string name;
 };
 
 template<>
-struct Parameter< Operation::CREATE_PATH >
+struct Parameter< Operation::CREATE_PATH > : public ClonableParameter< Operation::CREATE_PATH >
 {
     std::string path;
 };
 
 template<>
-struct Parameter< Operation::OPEN_PATH >
+struct Parameter< Operation::OPEN_PATH > : public ClonableParameter< Operation::OPEN_PATH >
 {
     std::string path;
 };
 
 template<>
-struct Parameter< Operation::DELETE_PATH >
+struct Parameter< Operation::DELETE_PATH > : public ClonableParameter< Operation::DELETE_PATH >
 {
     std::string path;
 };
 
 template<>
-struct Parameter< Operation::LIST_PATHS >
+struct Parameter< Operation::LIST_PATHS > : public ClonableParameter< Operation::LIST_PATHS >
 {
     std::shared_ptr< std::vector< std::string > > paths
             = std::make_shared< std::vector< std::string > >();
 };
 
 template<>
-struct Parameter< Operation::CREATE_DATASET >
+struct Parameter< Operation::CREATE_DATASET > : public ClonableParameter< Operation::CREATE_DATASET >
 {
     std::string name;
     Extent extent;
     Datatype dtype;
+    Dataset::Layout layout = Dataset::Layout::CHUNKED;
     Extent chunkSize;
     std::string compression;
     std::string transform;
+    std::vector< Dataset::Filter > filters;
+    Dataset::FillTime fillTime = Dataset::FillTime::DEFAULT;
+    Dataset::AllocationTime allocationTime = Dataset::AllocationTime::DEFAULT;
 };
 
 template<>
-struct Parameter< Operation::EXTEND_DATASET >
+struct Parameter< Operation::EXTEND_DATASET > : public ClonableParameter< Operation::EXTEND_DATASET >
 {
     std::string name;
     Extent extent;
 };
 
 template<>
-struct Parameter< Operation::OPEN_DATASET >
+struct Parameter< Operation::OPEN_DATASET > : public ClonableParameter< Operation::OPEN_DATASET >
 {
     std::string name;
     std::shared_ptr< Datatype > dtype
             = std::make_shared< Datatype >();
     std::shared_ptr< Extent > extent
             = std::make_shared< Extent >();
+    std::shared_ptr< Dataset::Layout > layout
+            = std::make_shared< Dataset::Layout >(Dataset::Layout::DEFAULT);
+    std::shared_ptr< Extent > chunkSize /* empty if the dataset is not chunked */
+            = std::make_shared< Extent >();
+    std::shared_ptr< std::vector< Dataset::Filter > > filters
+            = std::make_shared< std::vector< Dataset::Filter > >();
+
+    /**
+     * @return  Description of the opened dataset, only valid after the operation has completed.
+     */
+    Dataset dataset() const
+    {
+        Dataset d(*dtype, *extent);
+        d.layout = *layout;
+        d.chunkSize = *chunkSize;
+        d.filters = *filters;
+        return d;
+    }
 };
 
 template<>
-struct Parameter< Operation::DELETE_DATASET >
+struct Parameter< Operation::DELETE_DATASET > : public ClonableParameter< Operation::DELETE_DATASET >
 {
     std::string name;
 };
 
 template<>
-struct Parameter< Operation::WRITE_DATASET >
+struct Parameter< Operation::WRITE_DATASET > : public ClonableParameter< Operation::WRITE_DATASET >
 {
     Extent extent;
     Offset offset;
-    Datatype dtype;
+    Datatype dtype; /* type of the values in data, converted to the type of the dataset */
     std::shared_ptr< void > data;
+    MemoryLayout layout; /* placement of the chunk inside data */
 };
 
 template<>
-struct Parameter< Operation::READ_DATASET >
+struct Parameter< Operation::READ_DATASET > : public ClonableParameter< Operation::READ_DATASET >
 {
     Extent extent;
     Offset offset;
-    Datatype dtype;
+    Datatype dtype; /* type of the values in data, converted from the type of the dataset */
     void* data = nullptr;
+    MemoryLayout layout; /* placement of the chunk inside data */
 };
 
 template<>
-struct Parameter< Operation::LIST_DATASETS >
+struct Parameter< Operation::LIST_DATASETS > : public ClonableParameter< Operation::LIST_DATASETS >
 {
     std::shared_ptr< std::vector< std::string > > datasets
             = std::make_shared< std::vector< std::string > >();
 };
 
 template<>
-struct Parameter< Operation::DELETE_ATT >
+struct Parameter< Operation::DELETE_ATT > : public ClonableParameter< Operation::DELETE_ATT >
 {
     std::string name;
 };
 
 template<>
-struct Parameter< Operation::WRITE_ATT >
+struct Parameter< Operation::WRITE_ATT > : public ClonableParameter< Operation::WRITE_ATT >
 {
     Attribute::resource resource;
     std::string name;
@@ -194,7 +219,7 @@ struct Parameter< Operation::WRITE_ATT >
 };
 
 template<>
-struct Parameter< Operation::READ_ATT >
+struct Parameter< Operation::READ_ATT > : public ClonableParameter< Operation::READ_ATT >
 {
     std::string name;
     std::shared_ptr< Datatype > dtype
@@ -204,16 +229,19 @@ struct Parameter< Operation::READ_ATT >
 };
 
 template<>
-struct Parameter< Operation::LIST_ATTS >
+struct Parameter< Operation::LIST_ATTS > : public ClonableParameter< Operation::LIST_ATTS >
 {
     std::shared_ptr< std::vector< std::string > > attributes
             = std::make_shared< std::vector< std::string > >();
 };
 
+template<>
+struct Parameter< Operation::READ_ALL_ATTS > : public ClonableParameter< Operation::READ_ALL_ATTS >
+{
+    std::shared_ptr< std::map< std::string, Attribute > > attributes
+            = std::make_shared< std::map< std::string, Attribute > >();
+};
 
-template< Operation o >
-std::map< std::string, ParameterArgument >
-structToMap(Parameter< o > const&);
 
 /** @brief Self-contained description of a single IO operation.
  *
@@ -237,10 +265,24 @@ public:
            Parameter< op > const& p)
             : writable{w},
               operation{op},
-              parameter{structToMap(p)}
+              parameter{p.clone()}
     { }
 
+    /** Access the typed parameters of this task.
+     *
+     * @throws  std::runtime_error if op differs from the Operation of this task.
+     * @tparam  op  Operation of this task.
+     * @return  Reference to the Parameter object supplied during construction.
+     */
+    template< Operation op >
+    Parameter< op >& get() const
+    {
+        if( operation != op )
+            throw std::runtime_error("Requested Parameter does not match the Operation of the IOTask");
+        return *static_cast< Parameter< op >* >(parameter.get());
+    }
+
     Writable* writable;
     Operation operation;
-    std::map< std::string, ParameterArgument > parameter;
+    std::shared_ptr< AbstractParameter > parameter;
 };  //IOTask
@@ -40,6 +40,8 @@ class Iteration : public Attributable
     >
     friend class Container;
     friend class Series;
+    friend void onAccess(Iteration&);
+    friend void onLoad(Iteration&);
 
 public:
     Iteration(Iteration const&);
@@ -85,6 +87,18 @@ public:
      */
     Iteration& setTimeUnitSI(double timeUnitSI);
 
+    /** Write all pending changes of this iteration and release the resources held for it.
+     *
+     * In a fileBased series the file of this iteration is closed and skipped by subsequent
+     * flushes of the series. Accessing the iteration through Series::iterations re-opens it.
+     * Changes made through references retained before closing are still written: the next
+     * flush of the series re-opens the file for them and closes it again.
+     * In a groupBased series all iterations share one file, hence only pending changes are written.
+     *
+     * @return  Reference to closed iteration.
+     */
+    Iteration& close();
+
     Container< Mesh > meshes;
     Container< ParticleSpecies > particles; //particleSpecies?
 
@@ -95,8 +109,27 @@ private:
     void flushGroupBased(uint64_t);
     void flush();
     void read();
+
+    /** Mark this iteration as present on disk without reading it yet.
+     *
+     * @param   file    Name of the file containing the iteration (fileBased series only, empty otherwise).
+     * @param   path    Name of the iteration group relative to the basePath.
+     */
+    void deferRead(std::string const& file, std::string const& path);
+    /** Read this iteration if its parsing has been deferred, do nothing otherwise. */
+    void readDeferred();
+
+    bool m_closed;
+    bool m_deferred;
+    std::string m_deferredFile;
+    std::string m_deferredPath;
 };  //Iteration
 
+/** Read a lazily opened iteration or re-open a closed iteration on its access through its container. */
+void onAccess(Iteration&);
+/** Read a lazily opened iteration before it is handed out by its container without access by key. */
+void onLoad(Iteration&);
+
 extern template
 float
 Iteration::time< float >() const;
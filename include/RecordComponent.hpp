@@ -1,9 +1,13 @@
 #pragma once
 
 
+#include <algorithm>
 #include <cmath>
+#include <cstring>
 #include <memory>
 
+#include "auxiliary/Memory.hpp"
+#include "auxiliary/UnitScaling.hpp"
 #include "backend/BaseRecordComponent.hpp"
 #include "Dataset.hpp"
 
@@ -31,24 +35,98 @@ public:
         AUTO
     };  //Allocation
 
+    /** Copies hold their own copy of the pending chunks, which count towards Series::pendingBytes. */
+    RecordComponent(RecordComponent const&);
+    RecordComponent& operator=(RecordComponent const&);
+    /** Chunks that have not been flushed are discarded and no longer count towards Series::pendingBytes. */
+    ~RecordComponent();
+
     RecordComponent& setUnitSI(double);
 
     RecordComponent& resetDataset(Dataset);
 
     uint8_t getDimensionality();
     Extent getExtent();
+    /**
+     * @return  Layout of the dataset in storage, Dataset::Layout::DEFAULT until the dataset has been flushed or read.
+     */
+    Dataset::Layout getLayout();
+    /**
+     * @return  Extent of the storage chunks of the dataset, empty if it is not chunked or
+     *          if its shape is chosen automatically and the dataset has not been flushed yet.
+     */
+    Extent getChunkSize();
+    /**
+     * @return  Filters applied to the stored chunks of the dataset, in the order they are applied when writing.
+     */
+    std::vector< Dataset::Filter > getFilters();
 
     template< typename T >
     RecordComponent& makeConstant(T);
 
+    /** Read a chunk into a dense buffer.
+     *
+     * Numeric values are converted to T, values out of its range are clamped.
+     *
+     * @param   offset          Offset of the chunk in the dataset.
+     * @param   extent          Extent of the chunk.
+     * @param   data            Buffer receiving the chunk.
+     * @param   allocation      Whether data is allocated by the caller or by this call.
+     * @param   targetUnitSI    Unit to convert the values to, given as the factor to SI. NaN for the stored unit.
+     */
+    template< typename T >
+    void loadChunk(Offset const& offset,
+                   Extent const& extent,
+                   std::unique_ptr< T[] >& data,
+                   Allocation allocation = Allocation::AUTO,
+                   double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Read a chunk into its placement inside a larger buffer.
+     *
+     * @param   offset          Offset of the chunk in the dataset.
+     * @param   extent          Extent of the chunk.
+     * @param   data            Buffer receiving the chunk, must be allocated according to the layout.
+     * @param   layout          Placement of the chunk inside data, e.g. excluding guard cells or selecting one member of an array of structs.
+     * @param   targetUnitSI    Unit to convert the values to, given as the factor to SI. NaN for the stored unit.
+     */
     template< typename T >
-    void loadChunk(Offset const&,
-                   Extent const&,
-                   std::unique_ptr< T[] >&,
-                   Allocation = Allocation::AUTO,
+    void loadChunk(Offset const& offset,
+                   Extent const& extent,
+                   std::shared_ptr< T > data,
+                   MemoryLayout const& layout,
                    double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Read a chunk straight into a region of a larger row-major array.
+     *
+     * Useful to assemble a global array from several chunks or to read into padded arrays without an intermediate copy.
+     *
+     * @param   offset              Offset of the chunk in the dataset.
+     * @param   extent              Extent of the chunk.
+     * @param   data                Pointer to the first element of the destination array, owned by the caller.
+     * @param   destinationShape    Extent of the whole destination array.
+     * @param   destinationOffset   Position of the chunk inside the destination array.
+     * @param   targetUnitSI        Unit to convert the values to, given as the factor to SI. NaN for the stored unit.
+     */
+    template< typename T >
+    void loadChunk(Offset const& offset,
+                   Extent const& extent,
+                   T* data,
+                   Extent const& destinationShape,
+                   Offset const& destinationOffset,
+                   double targetUnitSI = std::numeric_limits< double >::quiet_NaN() );
+    /** Write a dense chunk.
+     *
+     * Numeric values are converted to the datatype of the dataset, values out of its range are clamped.
+     */
     template< typename T >
     void storeChunk(Offset, Extent, std::shared_ptr< T >);
+    /** Write a chunk from its placement inside a larger buffer without packing it first.
+     *
+     * @param   offset  Offset of the chunk in the dataset.
+     * @param   extent  Extent of the chunk.
+     * @param   data    Buffer holding the chunk.
+     * @param   layout  Placement of the chunk inside data, e.g. excluding guard cells or selecting one member of an array of structs.
+     */
+    template< typename T >
+    void storeChunk(Offset offset, Extent extent, std::shared_ptr< T > data, MemoryLayout layout);
 
     constexpr static char const * const SCALAR = "\vScalar";
 
@@ -58,10 +136,30 @@ protected:
     void readBase();
 
     std::queue< IOTask > m_chunks;
+    size_t m_pendingBytes; /* size of the chunks in m_chunks */
     Attribute m_constantValue;
 
 private:
     void flush(std::string const&);
+    /** Ensure the chunk resides inside the buffer described by the layout.
+     *
+     * @throws  std::runtime_error
+     */
+    void checkMemoryLayout(Extent const&, MemoryLayout const&) const;
+    /** Hand the pending chunks to the backend, requires the dataset to exist. */
+    void flushChunks();
+    /** Write the chunks of the components with the most pending bytes if the pending chunks of all components exceed their limit.
+     *
+     * Blocks until the chunks have been written. Only if chunks of components without a dataset remain above the limit,
+     * the enclosing series is flushed to create their datasets.
+     */
+    void limitPendingBytes();
+    /** Provide a buffer to copy a chunk into in copy-on-store mode.
+     *
+     * Takes the buffer from the staging pool, flushing the enclosing series to recycle written buffers if the pool is exhausted.
+     * Chunks that exceed the pool are copied into memory allocated for them alone.
+     */
+    std::shared_ptr< void > stagingBuffer(size_t bytes);
     virtual void read();
 };  //RecordComponent
 
@@ -82,11 +180,38 @@ template< typename T >
 inline void
 RecordComponent::loadChunk(Offset const& o, Extent const& e, std::unique_ptr< T[] >& data, Allocation alloc, double targetUnitSI)
 {
-    if( !std::isnan(targetUnitSI) )
-        throw std::runtime_error("unitSI scaling during chunk loading not yet implemented");
+    if( Allocation::API == alloc && data )
+        throw std::runtime_error("Preallocated pointer passed with signaled API-allocation during chunk loading.");
+    else if( Allocation::USER == alloc && !data )
+        throw std::runtime_error("Unallocated pointer passed with signaled user-allocation during chunk loading.");
+
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : e )
+        numPoints *= dimensionSize;
+
+    if( (Allocation::AUTO == alloc && !data) || Allocation::API == alloc )
+        data = std::unique_ptr< T[] >(new T[numPoints]);
+
+    /* the buffer is owned by the caller during the whole operation */
+    loadChunk(o, e, std::shared_ptr< T >(data.get(), [](T*){ }), MemoryLayout(), targetUnitSI);
+}
+
+template< typename T >
+inline void
+RecordComponent::loadChunk(Offset const& o, Extent const& e, T* data, Extent const& destinationShape, Offset const& destinationOffset, double targetUnitSI)
+{
+    /* the array is owned by the caller during the whole operation */
+    loadChunk(o, e, std::shared_ptr< T >(data, [](T*){ }), MemoryLayout(destinationShape, destinationOffset), targetUnitSI);
+}
+
+template< typename T >
+inline void
+RecordComponent::loadChunk(Offset const& o, Extent const& e, std::shared_ptr< T > data, MemoryLayout const& layout, double targetUnitSI)
+{
+    /* numeric values are converted by the backend while reading */
     Datatype dtype = determineDatatype(std::shared_ptr< T >());
-    if( dtype != getDatatype() )
-        throw std::runtime_error("Type conversion during chunk loading not yet implemented");
+    if( dtype != getDatatype() && !(isNumeric(dtype) && isNumeric(getDatatype())) )
+        throw std::runtime_error("Type conversion during chunk loading is only supported between numeric datatypes");
 
     uint8_t dim = getDimensionality();
     if( e.size() != dim || o.size() != dim )
@@ -98,36 +223,51 @@ RecordComponent::loadChunk(Offset const& o, Extent const& e, std::unique_ptr< T[
                                      + " - DS: " + std::to_string(dse[i])
                                      + " - Chunk: " + std::to_string(o[i] + e[i])
                                      + ")");
-    if( Allocation::API == alloc && data )
-        throw std::runtime_error("Preallocated pointer passed with signaled API-allocation during chunk loading.");
-    else if( Allocation::USER == alloc && !data )
-        throw std::runtime_error("Unallocated pointer passed with signaled user-allocation during chunk loading.");
+    if( !data )
+        throw std::runtime_error("Unallocated pointer passed during chunk loading.");
+    checkMemoryLayout(e, layout);
 
     size_t numPoints = 1;
     for( auto const& dimensionSize : e )
         numPoints *= dimensionSize;
 
-    if( (Allocation::AUTO == alloc && !data) || Allocation::API == alloc )
-        data = std::unique_ptr< T[] >(new T[numPoints]);
     T* raw_ptr = data.get();
+    double const factor = std::isnan(targetUnitSI) ? 1. : unitSI() / targetUnitSI;
 
     if( m_isConstant )
     {
-        Parameter< Operation::READ_ATT > aRead;
-        aRead.name = "value";
-        IOHandler->enqueue(IOTask(this, aRead));
+        /* the value is known since the component has been created or read */
+        T value = getNumeric< T >(m_constantValue);
+        if( factor != 1. )
+            scaleElements(&value, 1, factor);
+        if( layout.dense() )
+            parallelFill(raw_ptr, numPoints, value);
+        else
+            forEachLayoutRun(e, layout,
+                             [raw_ptr, value](size_t, size_t placed, size_t n)
+                             { std::fill(raw_ptr + placed, raw_ptr + placed + n, value); });
+    } else if( factor == 1. )
+    {
+        Parameter< Operation::READ_DATASET > dRead;
+        dRead.offset = o;
+        dRead.extent = e;
+        dRead.dtype = dtype;
+        dRead.data = raw_ptr;
+        dRead.layout = layout;
+        IOHandler->enqueue(IOTask(this, dRead));
         IOHandler->flush();
-        T value = Attribute(*aRead.resource).get< T >();
-        std::fill(raw_ptr, raw_ptr + numPoints, value);
     } else
     {
+        /* the chunk is read at once, so that no storage chunk is read and decoded twice */
         Parameter< Operation::READ_DATASET > dRead;
         dRead.offset = o;
         dRead.extent = e;
-        dRead.dtype = getDatatype();
+        dRead.dtype = dtype;
         dRead.data = raw_ptr;
+        dRead.layout = layout;
         IOHandler->enqueue(IOTask(this, dRead));
         IOHandler->flush();
+        parallelScale(raw_ptr, e, layout, factor);
     }
 }
 
@@ -186,11 +326,19 @@ RecordComponent::loadChunk(Offset const& o, Extent const& e, std::unique_ptr< T[
 template< typename T >
 inline void
 RecordComponent::storeChunk(Offset o, Extent e, std::shared_ptr<T> data)
+{
+    storeChunk(std::move(o), std::move(e), std::move(data), MemoryLayout());
+}
+
+template< typename T >
+inline void
+RecordComponent::storeChunk(Offset o, Extent e, std::shared_ptr<T> data, MemoryLayout layout)
 {
     if( m_isConstant )
         throw std::runtime_error("Chunks can not be written for a constant RecordComponent.");
+    /* numeric values are converted by the backend while writing */
     Datatype dtype = determineDatatype(data);
-    if( dtype != getDatatype() )
+    if( dtype != getDatatype() && !(isNumeric(dtype) && isNumeric(getDatatype())) )
         throw std::runtime_error("Datatypes of chunk and dataset do not match.");
     uint8_t dim = getDimensionality();
     if( e.size() != dim || o.size() != dim )
@@ -202,6 +350,11 @@ RecordComponent::storeChunk(Offset o, Extent e, std::shared_ptr<T> data)
                                      + " - DS: " + std::to_string(dse[i])
                                      + " - Chunk: " + std::to_string(o[i] + e[i])
                                      + ")");
+    checkMemoryLayout(e, layout);
+
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : e )
+        numPoints *= dimensionSize;
 
     Parameter< Operation::WRITE_DATASET > dWrite;
     dWrite.offset = o;
@@ -209,5 +362,22 @@ RecordComponent::storeChunk(Offset o, Extent e, std::shared_ptr<T> data)
     dWrite.dtype = dtype;
     /* std::static_pointer_cast correctly reference-counts the pointer */
     dWrite.data = std::static_pointer_cast< void >(data);
+    dWrite.layout = std::move(layout);
+    if( IOHandler->stagingBuffers && std::is_trivially_copyable< T >::value )
+    {
+        /* release the memory of the caller right away */
+        std::shared_ptr< void > staged = stagingBuffer(numPoints * sizeof(T));
+        if( dWrite.layout.dense() )
+            std::memcpy(staged.get(), data.get(), numPoints * sizeof(T));
+        else
+            packChunk(staged.get(), data.get(), e, dWrite.layout, sizeof(T));
+        dWrite.data = std::move(staged);
+        dWrite.layout = MemoryLayout();
+    }
     m_chunks.push(IOTask(this, dWrite));
-}
\ No newline at end of file
+    m_pendingBytes += numPoints * sizeof(T);
+    IOHandler->pendingBytes += numPoints * sizeof(T);
+    IOHandler->pendingComponents.insert(this);
+    setDirtyRecursive();
+    limitPendingBytes();
+}
@@ -25,11 +25,35 @@
 #include "backend/Container.hpp"
 #include "IO/AbstractIOHandler.hpp"
 #include "IO/AccessType.hpp"
+#include "IO/FileTuning.hpp"
 #include "IO/Format.hpp"
 #include "Iteration.hpp"
 #include "IterationEncoding.hpp"
 
 
+/** Optional behaviour of Series::read.
+ *
+ * All settings default to reading the complete series when it is opened.
+ */
+struct ReadOptions
+{
+    /** Parse iterations on demand. Only the keys of all iterations are determined when opening the series.
+     *
+     * An iteration is read on its first access by key, i.e. via <CODE>iterations[i]</CODE>, <CODE>iterations.at(i)</CODE> or <CODE>iterations.find(i)</CODE>.
+     * Iterating over the container or looking iterations up in a const container reads all iterations that have not been read yet.
+     */
+    bool lazy = false;
+    /** Look the files of a fileBased series up in a sidecar index instead of scanning the directory. Requires lazy.
+     *
+     * The index is stored as a hidden file in the directory of the series and is regenerated automatically when the directory has been modified.
+     * A readonly series only uses an existing index and never writes one.
+     */
+    bool indexed = false;
+    /** Open the files of a fileBased series concurrently on worker threads while their metadata is parsed. Ignored if lazy. */
+    bool prefetch = false;
+};  //ReadOptions
+
+
 /** @brief  Root level of the openPMD hierarchy.
  *
  * Entry point and common link between all iterations of particle and mesh data.
@@ -47,12 +71,14 @@ public:
      * @param ie    <A HREF="https://github.com/openPMD/openPMD-standard/blob/latest/STANDARD.md#iterations-and-time-series">iterationEncoding</A> of multiple iterations in this series.
      * @param f     File format and IO backend to use for this series.
      * @param at    Access permissions for every file in this series.
+     * @param asynchronous  Flag indicating whether flushed operations should be executed by a dedicated IO thread. If <CODE>true</CODE>, flush() returns before the data is written.
      */
     static Series create(std::string const& path,
                          std::string const& name,
                          IterationEncoding ie,
                          Format f,
-                         AccessType at = AccessType::CREATE);
+                         AccessType at = AccessType::CREATE,
+                         bool asynchronous = false);
     /** Convenience constructor for read-only data.
      *
      * @param path      Directory of the data, relative(!) to the current working directory.
@@ -63,6 +89,18 @@ public:
                        std::string const& name,
                        bool readonly = true,
                        bool parallel = false);
+    /** Convenience constructor for read-only data with optional reading behaviour.
+     *
+     * @param path      Directory of the data, relative(!) to the current working directory.
+     * @param name      Concrete name of one file in series (fileBased series will be loaded according to iterationFormat). Must include file extension.
+     * @param options   Settings that change how the series is read.
+     * @param parallel  Flag indicating whether this series should be read with an MPI-compatible backend. If <CODE>true</CODE>, <CODE>MPI_init()</CODE> must be called before.
+     */
+    static Series read(std::string const& path,
+                       std::string const& name,
+                       ReadOptions const& options,
+                       bool readonly = true,
+                       bool parallel = false);
     ~Series();
 
     /**
@@ -206,9 +244,82 @@ public:
      */
     Series& setName(std::string const& name);
 
+    /** Limit the number of files the backend keeps open simultaneously.
+     *
+     * Least recently used files beyond the limit are closed and re-opened transparently on their next access.
+     * This bounds the number of file descriptors and in-memory metadata caches when hopping between the iterations of a fileBased series.
+     * Backends without support for a limit ignore it.
+     *
+     * @param   maxOpenFiles    Maximum number of open files, 0 for no limit (the default).
+     * @return  Reference to modified series.
+     */
+    Series& setMaxOpenFiles(size_t maxOpenFiles);
+
+    /** Apply the filters of filtered datasets (e.g. compression) on multiple threads.
+     *
+     * By default, the backend library filters all chunks of a dataset one after another.
+     * With threads enabled, written regions that consist of whole storage chunks are filtered
+     * concurrently and handed to the backend as is; reads of such regions are reverted likewise.
+     * Other regions, filters that can only be applied by the backend, and backends without
+     * support for this (e.g. parallel HDF5) fall back to the default.
+     * The threads are started by this call and kept until the number is changed again or the series is destroyed.
+     *
+     * @param   numThreads  Number of threads to filter chunks on, 0 to leave filtering to the backend (the default).
+     * @return  Reference to modified series.
+     */
+    Series& setCompressionThreads(unsigned int numThreads);
+
+    /** Tune the layout and caching of the files of this series on the storage backend.
+     *
+     * Settings apply to files created or opened after this call, i.e. they should be set
+     * before the first flush of a new series. Backends ignore settings they do not support.
+     *
+     * @throw   std::runtime_error  If the alignment is zero or the page size is non-zero but smaller than 512 bytes.
+     * @param   tuning  Settings to apply.
+     * @return  Reference to modified series.
+     */
+    Series& setFileTuning(FileTuning const& tuning);
+
+    /** Copy chunks into pooled staging buffers when they are stored.
+     *
+     * In this mode RecordComponent::storeChunk does not hold on to the memory of the caller, which can be reused or freed
+     * right after the call. Staging buffers are recycled once the backend has written their content.
+     * If the pool is exhausted, the series is flushed and blocks until the staged chunks have been written to recycle their buffers.
+     * Chunks larger than the capacity of the pool are copied into memory allocated for them alone.
+     *
+     * @param   maxBytes    Maximum amount of memory held by staging buffers in bytes, 0 to reference the memory of the caller (the default).
+     * @return  Reference to modified series.
+     */
+    Series& setCopyOnStore(size_t maxBytes);
+
+    /**
+     * @return  Size of all stored chunks that have not been handed to the backend yet in bytes.
+     */
+    size_t pendingBytes() const;
+    /** Bound the amount of memory referenced by stored chunks that have not been flushed yet.
+     *
+     * A chunk that makes the pending chunks exceed the limit triggers writing the chunks of the components with the most pending bytes
+     * until the limit is met again. This blocks until these chunks have been written, also for asynchronous series.
+     * Components whose dataset has not been created yet are only written by a flush of the whole series,
+     * which is triggered if their chunks alone exceed the limit.
+     *
+     * @param   maxPendingBytes Maximum size of pending chunks in bytes, 0 for no limit (the default).
+     * @return  Reference to modified series.
+     */
+    Series& setMaxPendingBytes(size_t maxPendingBytes);
+
     /** Execute all required remaining IO operations to write or read data.
+     *
+     * For asynchronous series, the chunks stored since the last flush are written in the background,
+     * all other operations are executed before returning.
+     * Until the returned future is ready, the buffers of these chunks must stay untouched
+     * and their RecordComponents must not be reset, made constant or erased.
+     * Any other modification of the series (e.g. storing further chunks or setting attributes) is allowed.
+     * Any subsequent flush blocks until previous operations completed.
+     *
+     * @return  Future that becomes ready once all operations completed.
      */
-    void flush();
+    std::future< void > flush();
 
     Container< Iteration, uint64_t > iterations;
 
@@ -218,20 +329,26 @@ private:
            std::string const& name,
            IterationEncoding ie,
            Format f,
-           AccessType at);
+           AccessType at,
+           bool asynchronous);
 
     // TODO replace entirely with factory
     Series(std::string path,
            std::string const& name,
            bool readonly,
-           bool parallel);
+           bool parallel,
+           ReadOptions const& options);
 
     void flushFileBased();
     void flushGroupBased();
-    void readFileBased();
-    void readGroupBased();
+    void readFileBased(bool lazy, bool indexed, bool prefetch);
+    void readGroupBased(bool lazy);
     void readBase();
-    void read();
+    void read(bool lazy);
+    std::string indexPath() const;
+    bool createIndex() const;
+    bool readIndex(std::vector< std::string >& files) const;
+    void writeIndex(std::vector< std::string > const& files, int64_t directoryTime, int64_t scanTime) const;
 
     static std::string cleanFilename(std::string, Format);
 
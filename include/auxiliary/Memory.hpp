@@ -1,11 +1,17 @@
 #pragma once
 
+#include <algorithm>
+#include <cstring>
 #include <functional>
 #include <memory>
+#include <stdexcept>
+#include <thread>
+#include <vector>
 
+#include "Dataset.hpp"
 #include "Datatype.hpp"
 
-std::unique_ptr< void, std::function< void(void*) > >
+inline std::unique_ptr< void, std::function< void(void*) > >
 allocatePtr(Datatype dtype, size_t numPoints)
 {
     void* data = nullptr;
@@ -67,4 +73,208 @@ allocatePtr(Datatype dtype, size_t numPoints)
     }
 
     return std::move(std::unique_ptr< void, std::function< void(void*) > >(data, del));
-}
\ No newline at end of file
+}
+
+/** Copy a contiguous row-major chunk to its position inside a larger row-major box.
+ *
+ * @param   dst         Pointer to the buffer holding the box.
+ * @param   boxExtent   Extent of the box in elements.
+ * @param   offset      Offset of the chunk relative to the origin of the box.
+ * @param   src         Pointer to the buffer holding the chunk.
+ * @param   extent      Extent of the chunk in elements. Must be of same dimensionality as the box.
+ * @param   elementSize Size of a single element in bytes.
+ */
+inline void
+copyChunkIntoBox(void* dst,
+                 Extent const& boxExtent,
+                 Offset const& offset,
+                 void const* src,
+                 Extent const& extent,
+                 size_t elementSize)
+{
+    size_t const rank = extent.size();
+    if( rank == 0 )
+        return;
+
+    size_t const rowSize = extent[rank - 1] * elementSize;
+    size_t numRows = 1;
+    for( size_t k = 0; k + 1 < rank; ++k )
+        numRows *= extent[k];
+
+    char* out = static_cast< char* >(dst);
+    char const* in = static_cast< char const* >(src);
+    std::vector< uint64_t > index(rank, 0);
+    for( size_t row = 0; row < numRows; ++row )
+    {
+        uint64_t linear = 0;
+        for( size_t k = 0; k < rank; ++k )
+            linear = linear * boxExtent[k] + offset[k] + index[k];
+        std::memcpy(out + linear * elementSize, in + row * rowSize, rowSize);
+
+        /* advance the multi-index of all but the contiguous dimension */
+        for( size_t k = rank - 1; k-- > 0; )
+        {
+            if( ++index[k] < extent[k] )
+                break;
+            index[k] = 0;
+        }
+    }
+}
+
+/** Copy a box of elements between two row-major buffers of possibly different extents.
+ *
+ * @param   dst         Pointer to the buffer receiving the box.
+ * @param   dstExtent   Extent of the receiving buffer in elements.
+ * @param   dstOffset   Position of the box inside the receiving buffer.
+ * @param   src         Pointer to the buffer holding the box.
+ * @param   srcExtent   Extent of the source buffer in elements.
+ * @param   srcOffset   Position of the box inside the source buffer.
+ * @param   extent      Extent of the box in elements. All arguments must be of same dimensionality.
+ * @param   elementSize Size of a single element in bytes.
+ */
+inline void
+copyBox(void* dst,
+        Extent const& dstExtent,
+        Offset const& dstOffset,
+        void const* src,
+        Extent const& srcExtent,
+        Offset const& srcOffset,
+        Extent const& extent,
+        size_t elementSize)
+{
+    size_t const rank = extent.size();
+    size_t numRows = 1;
+    for( size_t k = 0; k + 1 < rank; ++k )
+        numRows *= extent[k];
+    if( rank == 0 || numRows == 0 || extent[rank - 1] == 0 )
+        return;
+
+    size_t const rowSize = extent[rank - 1] * elementSize;
+    char* out = static_cast< char* >(dst);
+    char const* in = static_cast< char const* >(src);
+    std::vector< uint64_t > index(rank, 0);
+    for( size_t row = 0; row < numRows; ++row )
+    {
+        uint64_t linearOut = 0;
+        uint64_t linearIn = 0;
+        for( size_t k = 0; k < rank; ++k )
+        {
+            linearOut = linearOut * dstExtent[k] + dstOffset[k] + index[k];
+            linearIn = linearIn * srcExtent[k] + srcOffset[k] + index[k];
+        }
+        std::memcpy(out + linearOut * elementSize, in + linearIn * elementSize, rowSize);
+
+        for( size_t k = rank - 1; k-- > 0; )
+        {
+            if( ++index[k] < extent[k] )
+                break;
+            index[k] = 0;
+        }
+    }
+}
+
+/** Visit all contiguous runs of a chunk placed inside a buffer according to a layout.
+ *
+ * @param   extent  Extent of the chunk in elements.
+ * @param   layout  Placement of the chunk inside the buffer. Must not be dense and of same dimensionality as the chunk.
+ * @param   visit   Functor called with the index of the first element of a run in the dense chunk,
+ *                  the index of the same element in the buffer and the number of elements in the run.
+ */
+template< typename F >
+inline void
+forEachLayoutRun(Extent const& extent, MemoryLayout const& layout, F visit)
+{
+    size_t const rank = extent.size();
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : extent )
+        numPoints *= dimensionSize;
+    if( rank == 0 || numPoints == 0 )
+        return;
+
+    /* rows along the last dimension are only contiguous without a stride */
+    size_t const runLength = layout.stride[rank - 1] == 1 ? extent[rank - 1] : 1;
+    std::vector< uint64_t > index(rank, 0);
+    for( size_t dense = 0; dense < numPoints; dense += runLength )
+    {
+        uint64_t linear = 0;
+        for( size_t k = 0; k < rank; ++k )
+            linear = linear * layout.shape[k] + layout.offset[k] + index[k] * layout.stride[k];
+        visit(dense, static_cast< size_t >(linear), runLength);
+
+        for( size_t k = runLength == 1 ? rank : rank - 1; k-- > 0; )
+        {
+            if( ++index[k] < extent[k] )
+                break;
+            index[k] = 0;
+        }
+    }
+}
+
+/** Gather a chunk placed inside a buffer according to a layout into a dense buffer.
+ *
+ * @param   dst         Pointer to the dense buffer.
+ * @param   src         Pointer to the buffer holding the chunk.
+ * @param   extent      Extent of the chunk in elements.
+ * @param   layout      Placement of the chunk inside src.
+ * @param   elementSize Size of a single element in bytes.
+ */
+inline void
+packChunk(void* dst, void const* src, Extent const& extent, MemoryLayout const& layout, size_t elementSize)
+{
+    char* out = static_cast< char* >(dst);
+    char const* in = static_cast< char const* >(src);
+    forEachLayoutRun(extent, layout,
+                     [&](size_t dense, size_t placed, size_t n)
+                     { std::memcpy(out + dense * elementSize, in + placed * elementSize, n * elementSize); });
+}
+
+/** Scatter a dense chunk into its placement inside a buffer according to a layout.
+ *
+ * @param   dst         Pointer to the buffer receiving the chunk.
+ * @param   src         Pointer to the dense buffer.
+ * @param   extent      Extent of the chunk in elements.
+ * @param   layout      Placement of the chunk inside dst.
+ * @param   elementSize Size of a single element in bytes.
+ */
+inline void
+unpackChunk(void* dst, void const* src, Extent const& extent, MemoryLayout const& layout, size_t elementSize)
+{
+    char* out = static_cast< char* >(dst);
+    char const* in = static_cast< char const* >(src);
+    forEachLayoutRun(extent, layout,
+                     [&](size_t dense, size_t placed, size_t n)
+                     { std::memcpy(out + placed * elementSize, in + dense * elementSize, n * elementSize); });
+}
+
+/** Fill a contiguous range with a single value, splitting large ranges across threads.
+ *
+ * @param   data        Pointer to the first element of the range.
+ * @param   numPoints   Number of elements in the range.
+ * @param   value       Value to assign to all elements.
+ */
+template< typename T >
+inline void
+parallelFill(T* data, size_t numPoints, T const& value)
+{
+    /* threads only pay off for ranges well beyond the size of the caches */
+    constexpr size_t minPointsPerThread = 1u << 20;
+    size_t const numThreads = std::min< size_t >(std::max(1u, std::thread::hardware_concurrency()),
+                                                 numPoints / minPointsPerThread);
+    if( numThreads <= 1 )
+    {
+        std::fill(data, data + numPoints, value);
+        return;
+    }
+
+    size_t const pointsPerThread = numPoints / numThreads;
+    std::vector< std::thread > workers;
+    for( size_t t = 1; t < numThreads; ++t )
+    {
+        T* begin = data + t * pointsPerThread;
+        T* end = t + 1 == numThreads ? data + numPoints : begin + pointsPerThread;
+        workers.emplace_back([begin, end, &value]{ std::fill(begin, end, value); });
+    }
+    std::fill(data, data + pointsPerThread, value);
+    for( auto& worker : workers )
+        worker.join();
+}
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+
+/** Pool of reusable, aligned buffers to stage chunks in until they are written.
+ *
+ * Requested sizes are rounded up to the next power of two so that buffers of
+ * similar size can be recycled for each other. Buffers are returned to the
+ * pool as soon as the last reference to them is released, which may happen
+ * on a different thread than the one that acquired them.
+ * The total amount of memory held by the pool, in use or cached, never
+ * exceeds its capacity.
+ */
+class StagingBufferPool : public std::enable_shared_from_this< StagingBufferPool >
+{
+public:
+    /** Alignment of all buffers handed out by the pool in bytes. */
+    static constexpr size_t ALIGNMENT = 64;
+
+    explicit StagingBufferPool(size_t capacity)
+            : m_capacity{capacity},
+              m_allocated{0}
+    { }
+
+    ~StagingBufferPool()
+    {
+        for( auto& sizeClass : m_free )
+            for( char* storage : sizeClass.second )
+                delete[] storage;
+    }
+
+    /** Hand out a buffer of at least the requested size.
+     *
+     * @param   bytes   Minimum size of the buffer in bytes.
+     * @return  Buffer that is returned to the pool once the last copy of the pointer is released,
+     *          empty if the request does not fit into the capacity of the pool.
+     */
+    std::shared_ptr< void > acquire(size_t bytes)
+    {
+        size_t const size = sizeClass(bytes);
+        char* storage = nullptr;
+        {
+            std::lock_guard< std::mutex > lock(m_mutex);
+            auto& cached = m_free[size];
+            if( !cached.empty() )
+            {
+                storage = cached.back();
+                cached.pop_back();
+            } else
+            {
+                /* drop cached buffers of other sizes before giving up */
+                for( auto it = m_free.begin(); m_allocated + size > m_capacity && it != m_free.end(); ++it )
+                    while( !it->second.empty() && m_allocated + size > m_capacity )
+                    {
+                        delete[] it->second.back();
+                        it->second.pop_back();
+                        m_allocated -= it->first;
+                    }
+                if( m_allocated + size > m_capacity )
+                    return std::shared_ptr< void >();
+
+                storage = new char[size + ALIGNMENT - 1];
+                m_allocated += size;
+            }
+        }
+
+        std::weak_ptr< StagingBufferPool > pool = shared_from_this();
+        auto address = reinterpret_cast< std::uintptr_t >(storage);
+        void* aligned = reinterpret_cast< void* >((address + ALIGNMENT - 1) / ALIGNMENT * ALIGNMENT);
+        return std::shared_ptr< void >(aligned,
+                                       [pool, storage, size](void*)
+                                       {
+                                           if( auto p = pool.lock() )
+                                               p->release(storage, size);
+                                           else
+                                               delete[] storage;
+                                       });
+    }
+
+    /** @return Maximum number of bytes held by the pool. */
+    size_t capacity() const { return m_capacity; }
+
+    /** @return Number of bytes currently held by the pool, both in use and cached for reuse. */
+    size_t allocated() const
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        return m_allocated;
+    }
+
+private:
+    static size_t sizeClass(size_t bytes)
+    {
+        size_t size = ALIGNMENT;
+        while( size < bytes )
+            size *= 2;
+        return size;
+    }
+
+    void release(char* storage, size_t size)
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        m_free[size].push_back(storage);
+    }
+
+    size_t const m_capacity;
+    size_t m_allocated;
+    std::map< size_t, std::vector< char* > > m_free;
+    mutable std::mutex m_mutex;
+};  //StagingBufferPool
@@ -0,0 +1,200 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "auxiliary/Memory.hpp"
+
+
+/** Multiply a contiguous range of floating point values by a factor.
+ *
+ * The factor is applied in the precision of the elements so that the loop vectorizes.
+ */
+template< typename T >
+inline typename std::enable_if< std::is_floating_point< T >::value >::type
+scaleElements(T* data, size_t numPoints, double factor)
+{
+    T const f = static_cast< T >(factor);
+    for( size_t i = 0; i < numPoints; ++i )
+        data[i] *= f;
+}
+
+template< typename T >
+inline typename std::enable_if< std::is_signed< T >::value, bool >::type
+isNegativeInteger(T value)
+{
+    return value < 0;
+}
+
+template< typename T >
+inline typename std::enable_if< std::is_unsigned< T >::value, bool >::type
+isNegativeInteger(T)
+{
+    return false;
+}
+
+/** @return Absolute value of an integer, valid for the minimum of signed types as well. */
+template< typename T >
+inline uintmax_t
+integerMagnitude(T value)
+{
+    uintmax_t const bits = static_cast< uintmax_t >(value);
+    return isNegativeInteger(value) ? static_cast< uintmax_t >(0u) - bits : bits;
+}
+
+/** @return Integer of the given sign and magnitude, saturated to the range of T. */
+template< typename T >
+inline T
+saturatedInteger(bool negative, uintmax_t magnitude)
+{
+    if( negative && magnitude > 0 )
+    {
+        if( !std::is_signed< T >::value || magnitude > integerMagnitude(std::numeric_limits< T >::min()) )
+            return std::numeric_limits< T >::min();
+        /* -magnitude computed without overflowing for the minimum of T */
+        return static_cast< T >(-static_cast< T >(magnitude - 1u) - 1);
+    }
+    if( magnitude > static_cast< uintmax_t >(std::numeric_limits< T >::max()) )
+        return std::numeric_limits< T >::max();
+    return static_cast< T >(magnitude);
+}
+
+/** Multiply a contiguous range of integer values by a factor, rounding half away from zero.
+ *
+ * Results outside the range of T saturate to its minimum or maximum.
+ * Factors that are integers or reciprocals of integers are applied in integer arithmetic,
+ * which keeps 64 bit values exact. Other factors are applied in extended floating point precision.
+ *
+ * @throw   std::runtime_error  If the factor is not finite.
+ */
+template< typename T >
+inline typename std::enable_if< std::is_integral< T >::value && !std::is_same< T, bool >::value >::type
+scaleElements(T* data, size_t numPoints, double factor)
+{
+    if( !std::isfinite(factor) )
+        throw std::runtime_error("unitSI scaling of integers requires a finite factor");
+
+    bool const negativeFactor = factor < 0.;
+    double const absFactor = std::fabs(factor);
+    /* 2^64, the first double beyond the range of uintmax_t */
+    double const magnitudeLimit = std::ldexp(1., 64);
+
+    if( absFactor < magnitudeLimit && std::trunc(absFactor) == absFactor )
+    {
+        uintmax_t const k = static_cast< uintmax_t >(absFactor);
+        for( size_t i = 0; i < numPoints; ++i )
+        {
+            uintmax_t const m = integerMagnitude(data[i]);
+            bool const negative = isNegativeInteger(data[i]) != negativeFactor;
+            if( m != 0 && k > std::numeric_limits< uintmax_t >::max() / m )
+                data[i] = saturatedInteger< T >(negative, std::numeric_limits< uintmax_t >::max());
+            else
+                data[i] = saturatedInteger< T >(negative, m * k);
+        }
+        return;
+    }
+
+    double const divisor = 1. / absFactor;
+    if( divisor < magnitudeLimit && std::trunc(divisor) == divisor && 1. / divisor == absFactor )
+    {
+        uintmax_t const d = static_cast< uintmax_t >(divisor);
+        for( size_t i = 0; i < numPoints; ++i )
+        {
+            uintmax_t const m = integerMagnitude(data[i]);
+            uintmax_t const remainder = m % d;
+            uintmax_t const q = m / d + (remainder >= d - remainder ? 1u : 0u);
+            data[i] = saturatedInteger< T >(isNegativeInteger(data[i]) != negativeFactor, q);
+        }
+        return;
+    }
+
+    /* limits of T as powers of two are exact in floating point */
+    long double const upper = std::ldexp(1.L, std::numeric_limits< T >::digits);
+    long double const lower = std::is_signed< T >::value ? -upper : 0.L;
+    long double const f = factor;
+    for( size_t i = 0; i < numPoints; ++i )
+    {
+        long double const scaled = std::round(static_cast< long double >(data[i]) * f);
+        if( scaled >= upper )
+            data[i] = std::numeric_limits< T >::max();
+        else if( scaled < lower )
+            data[i] = std::numeric_limits< T >::min();
+        else
+            data[i] = static_cast< T >(scaled);
+    }
+}
+
+template< typename T >
+inline typename std::enable_if< !std::is_arithmetic< T >::value || std::is_same< T, bool >::value >::type
+scaleElements(T*, size_t, double)
+{
+    throw std::runtime_error("unitSI scaling is only supported for numeric datatypes");
+}
+
+/** Multiply the elements of a chunk placed in memory according to a layout by a factor.
+ *
+ * The rows of large chunks are split evenly among a fixed number of threads.
+ *
+ * @param   data        Buffer holding the chunk.
+ * @param   extent      Extent of the chunk.
+ * @param   layout      Placement of the chunk in the buffer.
+ * @param   factor      Factor to multiply all elements by.
+ */
+template< typename T >
+inline void
+parallelScale(T* data, Extent const& extent, MemoryLayout const& layout, double factor)
+{
+    size_t numPoints = 1;
+    for( auto const& dimensionSize : extent )
+        numPoints *= dimensionSize;
+    if( numPoints == 0 )
+        return;
+    uint64_t const rows = extent.empty() ? 1 : extent[0];
+    size_t const rowPoints = numPoints / rows;
+
+    auto scaleRows = [data, &extent, &layout, rowPoints, factor](uint64_t begin, uint64_t end)
+    {
+        if( layout.dense() )
+            scaleElements(data + begin * rowPoints, (end - begin) * rowPoints, factor);
+        else
+        {
+            Extent rowsExtent = extent;
+            rowsExtent[0] = end - begin;
+            MemoryLayout rowsLayout = layout;
+            rowsLayout.offset[0] += begin * layout.stride[0];
+            forEachLayoutRun(rowsExtent, rowsLayout,
+                             [data, factor](size_t, size_t placed, size_t n)
+                             { scaleElements(data + placed, n, factor); });
+        }
+    };
+
+    /* threads only pay off for ranges well beyond the size of the caches */
+    constexpr size_t minPointsPerThread = 1u << 20;
+    size_t const numThreads = std::min< size_t >(std::min< size_t >(std::max(1u, std::thread::hardware_concurrency()),
+                                                                    numPoints / minPointsPerThread),
+                                                 rows);
+    if( numThreads <= 1 )
+    {
+        scaleRows(0, rows);
+        return;
+    }
+
+    uint64_t const rowsPerThread = rows / numThreads;
+    std::vector< std::thread > workers;
+    for( size_t t = 1; t < numThreads; ++t )
+    {
+        uint64_t begin = t * rowsPerThread;
+        uint64_t end = t + 1 == numThreads ? rows : begin + rowsPerThread;
+        workers.emplace_back(scaleRows, begin, end);
+    }
+    scaleRows(0, rowsPerThread);
+    for( auto& worker : workers )
+        worker.join();
+}
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+/** Fixed set of threads that jobs are handed to.
+ *
+ * Threads are started when the pool is resized and live until it is resized
+ * again or destroyed, so submitting work does not create any threads.
+ */
+class WorkerPool
+{
+public:
+    WorkerPool()
+            : m_stop{false}
+    { }
+
+    ~WorkerPool()
+    {
+        resize(0);
+    }
+
+    WorkerPool(WorkerPool const&) = delete;
+    WorkerPool& operator=(WorkerPool const&) = delete;
+
+    /** Replace the threads of the pool, after running all jobs submitted so far.
+     *
+     * @param   numThreads  Number of threads, 0 to stop all threads.
+     */
+    void resize(unsigned int numThreads)
+    {
+        {
+            std::lock_guard< std::mutex > lock(m_mutex);
+            m_stop = true;
+        }
+        m_submitted.notify_all();
+        for( auto& worker : m_workers )
+            worker.join();
+        m_workers.clear();
+
+        m_stop = false;
+        for( unsigned int t = 0; t < numThreads; ++t )
+            m_workers.emplace_back(&WorkerPool::run, this);
+    }
+
+    /** @return Number of threads of the pool. */
+    unsigned int size() const { return static_cast< unsigned int >(m_workers.size()); }
+
+    /** Call a functor for all indices of a range on the threads of the pool without waiting for it.
+     *
+     * Objects referenced by the functor have to outlive the returned future becoming ready.
+     *
+     * @param   n   Number of indices.
+     * @param   f   Functor called with every index in [0, n) exactly once.
+     * @return  Future that becomes ready once all calls returned, holding the first exception thrown by any of them.
+     */
+    template< typename F >
+    std::future< void > forEach(size_t n, F f)
+    {
+        struct Range
+        {
+            Range(size_t count, F func) : n{count}, next{0}, remaining{count}, f(std::move(func)) { }
+
+            size_t const n;
+            std::atomic< size_t > next;
+            std::atomic< size_t > remaining;
+            F f;
+            std::promise< void > done;
+            std::exception_ptr error;
+            std::mutex errorMutex;
+        };
+        auto range = std::make_shared< Range >(n, std::move(f));
+        std::future< void > ret = range->done.get_future();
+        if( n == 0 )
+        {
+            range->done.set_value();
+            return ret;
+        }
+        if( m_workers.empty() )
+            throw std::runtime_error("WorkerPool without threads can not process jobs");
+
+        auto job = [range]()
+        {
+            for( size_t i = range->next++; i < range->n; i = range->next++ )
+            {
+                try
+                {
+                    range->f(i);
+                } catch( ... )
+                {
+                    std::lock_guard< std::mutex > lock(range->errorMutex);
+                    if( !range->error )
+                        range->error = std::current_exception();
+                }
+                if( --range->remaining == 0 )
+                {
+                    if( range->error )
+                        range->done.set_exception(range->error);
+                    else
+                        range->done.set_value();
+                }
+            }
+        };
+        {
+            std::lock_guard< std::mutex > lock(m_mutex);
+            for( size_t t = 0; t < std::min< size_t >(m_workers.size(), n); ++t )
+                m_jobs.push(job);
+        }
+        m_submitted.notify_all();
+        return ret;
+    }
+
+private:
+    void run()
+    {
+        while( true )
+        {
+            std::function< void() > job;
+            {
+                std::unique_lock< std::mutex > lock(m_mutex);
+                m_submitted.wait(lock, [this]{ return m_stop || !m_jobs.empty(); });
+                if( m_jobs.empty() )
+                    return;
+                job = std::move(m_jobs.front());
+                m_jobs.pop();
+            }
+            job();
+        }
+    }
+
+    std::vector< std::thread > m_workers;
+    std::queue< std::function< void() > > m_jobs;
+    bool m_stop;
+    std::mutex m_mutex;
+    std::condition_variable m_submitted;
+};  //WorkerPool
@@ -24,6 +24,7 @@
 #include <exception>
 #include <map>
 #include <memory>
+#include <set>
 #include <vector>
 
 #include "IO/AbstractIOHandler.hpp"
@@ -52,6 +53,7 @@ public:
 class Attributable : public Writable
 {
     using A_MAP = std::map< std::string, Attribute >;
+    using A_SET = std::set< std::string >;
 
 public:
     Attributable();
@@ -115,6 +117,10 @@ public:
     Attributable& setComment(std::string const& comment);
 
 protected:
+    /** Write Attributes that have been modified since the last flush.
+     *
+     * If the object itself has not been written yet, all Attributes are written.
+     */
     void flushAttributes();
     void readAttributes();
 
@@ -153,6 +159,7 @@ protected:
 
 private:
     std::shared_ptr< A_MAP > m_attributes;
+    std::shared_ptr< A_SET > m_dirtyAttributes;
 };  //Attributable
 
 void warnWrongDtype(std::string const& key,
@@ -165,6 +172,8 @@ inline bool
 Attributable::setAttribute(std::string const& key, T&& value)
 {
     dirty = true;
+    setDirtyRecursive();
+    m_dirtyAttributes->insert(key);
     auto it = m_attributes->lower_bound(key);
     if( it != m_attributes->end() && !m_attributes->key_comp()(key, it->first) )
     {
@@ -23,17 +23,14 @@
 
 #include <array>
 #include <cstdint>
+#include <stdexcept>
+#include <type_traits>
 #include <vector>
 
 #include "auxiliary/Variadic.hpp"
 #include "Datatype.hpp"
 
 
-//TODO This might have to be a Writable
-//Reasoning - Flushes are expeted to be done often.
-//Attributes should not be written unless dirty.
-//At the moment the dirty check is done at Attributable level,
-//resulting in all of an Attributables Attributes being written to disk even if only one changes
 /** Varidic datatype supporting at least all formats for attributes specified in the openPMD standard.
  *
  * @note Extending and/or modifying the available formats requires identical
@@ -59,3 +56,38 @@ using Attribute = Variadic< Datatype,
                             std::vector< std::string >,
                             std::array< double, 7 >,
                             bool >;
+
+/** Visitor converting a single numeric value to another numeric type.
+ */
+template< typename U >
+struct NumericCast : public boost::static_visitor< U >
+{
+    template< typename V >
+    typename std::enable_if< std::is_arithmetic< V >::value && std::is_arithmetic< U >::value, U >::type
+    operator()(V const& v) const
+    {
+        return static_cast< U >(v);
+    }
+
+    template< typename V >
+    typename std::enable_if< !std::is_arithmetic< V >::value || !std::is_arithmetic< U >::value, U >::type
+    operator()(V const&) const
+    {
+        throw std::runtime_error("Attribute can not be converted to the requested numeric type");
+    }
+};
+
+/** Retrieve a single numeric value stored in an Attribute as a possibly different numeric type.
+ *
+ * @tparam  U   Type to retrieve the value as.
+ * @param   a   Attribute holding the value.
+ * @return  Value converted to U.
+ */
+template< typename U >
+inline U
+getNumeric(Attribute const& a)
+{
+    if( decay_equiv< U, bool >::value || a.dtype == Datatype::BOOL || a.dtype == Datatype::STRING )
+        return a.get< U >();
+    return boost::apply_visitor(NumericCast< U >(), a.getResource());
+}
@@ -39,6 +39,12 @@ protected:
     BaseRecord();
 
     void readBase();
+    /** Whether this record or any of its components hold unflushed changes.
+     *
+     * A scalar component is attached to the parent of its record and thus
+     * does not propagate its changes through the record itself.
+     */
+    bool isDirtyRecursive() const;
 
     bool m_containsScalar;
 
@@ -111,6 +117,19 @@ BaseRecord< T_elem >::operator[](key_type&& key)
     }
 }
 
+template< typename T_elem >
+inline bool
+BaseRecord< T_elem >::isDirtyRecursive() const
+{
+    if( this->dirtyRecursive )
+        return true;
+    if( !m_containsScalar )
+        return false;
+
+    auto scalar = this->m_container.find(RecordComponent::SCALAR);
+    return scalar != this->m_container.end() && scalar->second.dirtyRecursive;
+}
+
 template< typename T_elem >
 inline typename BaseRecord< T_elem >::size_type
 BaseRecord< T_elem >::erase(key_type const& key)
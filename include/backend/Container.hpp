@@ -26,6 +26,26 @@
 #include "Attributable.hpp"
 
 
+/** Hook invoked on every existing element that is handed out by key.
+ *
+ * Element types requiring work on access (e.g. reading on demand) provide a
+ * non-template overload that is found through argument-dependent lookup.
+ */
+template< typename T >
+inline void
+onAccess(T&)
+{ }
+
+/** Hook invoked on every element before it is handed out without access by key (e.g. by iterators or const lookup).
+ *
+ * Element types that are read on demand provide a non-template overload that
+ * is found through argument-dependent lookup.
+ */
+template< typename T >
+inline void
+onLoad(T&)
+{ }
+
 /** @brief Map-like container that enforces openPMD requirements and handles IO.
  *
  * @see http://en.cppreference.com/w/cpp/container/map
@@ -64,9 +84,10 @@ public:
 
     virtual ~Container() { }
 
-    iterator begin() noexcept { return m_container.begin(); }
-    const_iterator begin() const noexcept { return m_container.begin(); }
-    const_iterator cbegin() const noexcept { return m_container.cbegin(); }
+    /** @note   Elements read on demand are all read before the first one is handed out. */
+    iterator begin() { loadAll(); return m_container.begin(); }
+    const_iterator begin() const { loadAll(); return m_container.begin(); }
+    const_iterator cbegin() const { loadAll(); return m_container.cbegin(); }
 
     iterator end() noexcept { return m_container.end(); }
     const_iterator end() const noexcept { return m_container.end(); }
@@ -101,8 +122,18 @@ public:
 
     void swap(Container & other) { m_container.swap(other.m_container); }
 
-    mapped_type& at(key_type const& key) { return m_container.at(key); }
-    mapped_type const& at(key_type const& key) const { return m_container.at(key); }
+    mapped_type& at(key_type const& key)
+    {
+        mapped_type& ret = m_container.at(key);
+        onAccess(ret);
+        return ret;
+    }
+    mapped_type const& at(key_type const& key) const
+    {
+        mapped_type const& ret = m_container.at(key);
+        onLoad(const_cast< mapped_type& >(ret));
+        return ret;
+    }
 
     /** Access the value that is mapped to a key equivalent to key, creating it if such key does not exist already.
      *
@@ -113,12 +144,16 @@ public:
     {
         auto it = m_container.find(key);
         if( it != m_container.end() )
+        {
+            onAccess(it->second);
             return it->second;
+        }
         else
         {
             T t = T();
             t.IOHandler = IOHandler;
             t.parent = this;
+            setDirtyRecursive();
             return m_container.insert({key, std::move(t)}).first->second;
         }
     }
@@ -131,20 +166,36 @@ public:
     {
         auto it = m_container.find(key);
         if( it != m_container.end() )
+        {
+            onAccess(it->second);
             return it->second;
+        }
         else
         {
             T t = T();
             t.IOHandler = IOHandler;
             t.parent = this;
+            setDirtyRecursive();
             return m_container.insert({std::move(key), std::move(t)}).first->second;
         }
     }
 
     size_type count(key_type const& key) const { return m_container.count(key); }
 
-    iterator find(key_type const& key) { return m_container.find(key); }
-    const_iterator find(key_type const& key) const { return m_container.find(key); }
+    iterator find(key_type const& key)
+    {
+        auto it = m_container.find(key);
+        if( it != m_container.end() )
+            onAccess(it->second);
+        return it;
+    }
+    const_iterator find(key_type const& key) const
+    {
+        auto it = m_container.find(key);
+        if( it != m_container.end() )
+            onLoad(const_cast< mapped_type& >(it->second));
+        return it;
+    }
 
     /** Remove a single element from the container and (if written) from disk.
      *
@@ -172,6 +223,13 @@ public:
 protected:
     InternalContainer m_container;
 
+    /* reading on demand does not change the logical state of the container */
+    void loadAll() const
+    {
+        for( auto const& e : m_container )
+            onLoad(const_cast< mapped_type& >(e.second));
+    }
+
     void clear_unchecked()
     {
         if( written )
@@ -187,7 +245,6 @@ protected:
             Parameter< Operation::CREATE_PATH > pCreate;
             pCreate.path = path;
             IOHandler->enqueue(IOTask(this, pCreate));
-            IOHandler->flush();
         }
 
         flushAttributes();
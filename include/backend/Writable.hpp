@@ -43,7 +43,11 @@ class Writable
             typename T_container
     >
     friend class Container;
+    template< typename T_elem >
+    friend class BaseRecord;
     friend class Iteration;
+    friend class ParticleSpecies;
+    friend class RecordComponent;
     friend class ADIOS1IOHandlerImpl;
     friend class ParallelADIOS1IOHandlerImpl;
     friend class ADIOS2IOHandlerImpl;
@@ -56,9 +60,14 @@ public:
     virtual ~Writable();
 
 protected:
+    /** Flag this object and all of its parents as containing changes that have not been flushed yet.
+     */
+    void setDirtyRecursive();
+
     std::shared_ptr< AbstractFilePosition > abstractFilePosition;
     Writable* parent;
     std::shared_ptr< AbstractIOHandler > IOHandler;
     bool dirty;
+    bool dirtyRecursive; /* this object or any of its children has unflushed changes */
     bool written;
 };
@@ -1,12 +1,96 @@
+#include <algorithm>
 #include <iostream>
 
 #include "Dataset.hpp"
 
+
+constexpr size_t Dataset::MAX_COMPACT_BYTES;
+constexpr size_t Dataset::DEFAULT_CHUNK_BYTES;
+
+MemoryLayout::MemoryLayout(Extent sh, Offset o, Extent st)
+        : shape{sh},
+          offset{o},
+          stride{st.empty() ? Extent(sh.size(), 1) : st}
+{
+    if( offset.size() != shape.size() || stride.size() != shape.size() )
+        throw std::runtime_error("Dimensionality of memory layout components must match");
+    for( auto const& s : stride )
+        if( s == 0 )
+            throw std::runtime_error("Memory layout stride must not be zero");
+}
+
+Dataset::Filter
+Dataset::Filter::shuffle()
+{
+    return Filter(2);
+}
+
+Dataset::Filter
+Dataset::Filter::fletcher32()
+{
+    return Filter(3);
+}
+
+Dataset::Filter
+Dataset::Filter::deflate(unsigned int level)
+{
+    if( level > 9 )
+        throw std::runtime_error("Compression level out of range for deflate");
+    return Filter(1, {level});
+}
+
+Dataset::Filter
+Dataset::Filter::szip(unsigned int pixelsPerBlock, bool nearestNeighbour)
+{
+    if( pixelsPerBlock % 2 != 0 || pixelsPerBlock > 32 )
+        throw std::runtime_error("szip requires an even number of pixels per block up to 32");
+    /* option mask as defined by H5_SZIP_NN_OPTION_MASK and H5_SZIP_EC_OPTION_MASK */
+    return Filter(4, {nearestNeighbour ? 32u : 4u, pixelsPerBlock});
+}
+
+Dataset::Filter
+Dataset::Filter::bitshuffle(bool lz4, unsigned int blockSize)
+{
+    /* the first three parameters are filled in by the filter itself */
+    return Filter(32008, {0, 0, 0, blockSize, lz4 ? 2u : 0u});
+}
+
+Dataset::Filter
+Dataset::Filter::lz4(unsigned int blockSize)
+{
+    return Filter(32004, {blockSize});
+}
+
+Dataset::Filter
+Dataset::Filter::zstd(int level)
+{
+    return Filter(32015, {static_cast< unsigned int >(level)});
+}
+
+Dataset::Filter
+Dataset::Filter::blosc(unsigned int level, bool shuffle, unsigned int compressor)
+{
+    if( level > 9 )
+        throw std::runtime_error("Compression level out of range for blosc");
+    /* the first four parameters are filled in by the filter itself */
+    return Filter(32001, {0, 0, 0, 0, level, shuffle ? 1u : 0u, compressor});
+}
+
+bool
+Dataset::Filter::operator==(Filter const& other) const
+{
+    return id == other.id && parameters == other.parameters && optional == other.optional;
+}
+
 Dataset::Dataset(Datatype d, Extent e)
         : extent{e},
           dtype{d},
           rank{static_cast<uint8_t>(e.size())},
-          chunkSize{e}
+          layout{Layout::DEFAULT},
+          chunkBytes{DEFAULT_CHUNK_BYTES},
+          chunkAccess{ChunkAccess::FULL},
+          fillTime{FillTime::DEFAULT},
+          allocationTime{AllocationTime::DEFAULT}
 { }
 
 Dataset&
@@ -25,13 +109,109 @@ Dataset::extend(Extent newExtents)
 Dataset&
 Dataset::setChunkSize(std::vector< size_t > const& cs)
 {
-    if( extent.size() != rank )
-        throw std::runtime_error("Dimensionality of extended Dataset must match the original dimensionality");
+    if( cs.size() != rank )
+        throw std::runtime_error("Dimensionality of Dataset chunk size must match the dimensionality of the Dataset");
     for( size_t i = 0; i < cs.size(); ++i )
+    {
+        if( cs[i] == 0 )
+            throw std::runtime_error("Dataset chunk size must not be zero");
         if( cs[i] > extent[i] )
             throw std::runtime_error("Dataset chunk size must be equal or smaller than Extent");
+    }
 
     chunkSize = cs;
+    layout = Layout::CHUNKED;
+    return *this;
+}
+
+Dataset&
+Dataset::setLayout(Layout l)
+{
+    layout = l;
+    return *this;
+}
+
+Dataset::Layout
+Dataset::resolvedLayout() const
+{
+    bool const needsChunks = !chunkSize.empty() || !filters.empty() || !compression.empty();
+    if( layout == Layout::DEFAULT )
+    {
+        /* empty extents are a hint that the dataset is going to be extended */
+        bool const empty = std::find(extent.begin(), extent.end(), 0u) != extent.end();
+        return needsChunks || empty ? Layout::CHUNKED : Layout::CONTIGUOUS;
+    }
+    if( layout != Layout::CHUNKED && needsChunks )
+        throw std::runtime_error("Chunk size, filters and compression require a chunked Dataset layout");
+    if( layout == Layout::COMPACT )
+    {
+        uint64_t bytes = toBytes(dtype);
+        for( auto const& e : extent )
+            bytes *= e;
+        if( bytes > MAX_COMPACT_BYTES )
+            throw std::runtime_error("Dataset too large for a compact layout");
+    }
+    return layout;
+}
+
+Dataset&
+Dataset::setAutomaticChunking(size_t targetBytes, ChunkAccess access)
+{
+    if( targetBytes == 0 )
+        throw std::runtime_error("Target size of automatically chosen chunks must not be zero");
+
+    chunkSize.clear();
+    layout = Layout::CHUNKED;
+    chunkBytes = targetBytes;
+    chunkAccess = access;
+    return *this;
+}
+
+Extent
+Dataset::automaticChunkSize() const
+{
+    /* empty dimensions of extensible datasets still need chunks of at least one element */
+    Extent chunk(extent);
+    for( auto& c : chunk )
+        c = std::max< uint64_t >(c, 1);
+
+    size_t const elementSize = std::max< size_t >(toBytes(dtype), 1);
+    auto bytes = [&]()
+    {
+        uint64_t b = elementSize;
+        for( auto const& c : chunk )
+            b *= c;
+        return b;
+    };
+    auto halve = [](uint64_t& c){ c = (c + 1) / 2; };
+
+    /* slices only cover a single index of the first dimension, so shrink that one first */
+    if( chunkAccess == ChunkAccess::SLICE && !chunk.empty() )
+        while( bytes() > chunkBytes && chunk[0] > 1 )
+            halve(chunk[0]);
+
+    /* halving the longest dimension keeps the chunk as evenly shaped as the extent allows */
+    while( bytes() > chunkBytes )
+    {
+        auto longest = std::max_element(chunk.begin(), chunk.end());
+        if( longest == chunk.end() || *longest == 1 )
+            break;
+        halve(*longest);
+    }
+    return chunk;
+}
+
+Dataset&
+Dataset::setFillTime(FillTime ft)
+{
+    fillTime = ft;
+    return *this;
+}
+
+Dataset&
+Dataset::setAllocationTime(AllocationTime at)
+{
+    allocationTime = at;
     return *this;
 }
 
@@ -55,4 +235,11 @@ Dataset::setCustomTransform(std::string const& parameter)
 {
     transform = parameter;
     return *this;
+}
+
+Dataset&
+Dataset::addFilter(Filter filter)
+{
+    filters.push_back(std::move(filter));
+    return *this;
 }
\ No newline at end of file
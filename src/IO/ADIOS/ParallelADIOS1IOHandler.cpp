@@ -21,8 +21,7 @@ public:
 
     std::future< void > flush();
 
-    using ArgumentMap = std::map< std::string, ParameterArgument >;
-    void createFile(Writable*, ArgumentMap const&);
+    void createFile(Writable*, Parameter< Operation::CREATE_FILE > const&);
 
     MPI_Comm m_mpiComm;
     MPI_Info m_mpiInfo;
@@ -85,55 +84,55 @@ ParallelADIOS1IOHandlerImpl::flush()
         {
             using O = Operation;
             case O::CREATE_FILE:
-                createFile(i.writable, i.parameter);
+                createFile(i.writable, i.get< O::CREATE_FILE >());
                 break;
             case O::CREATE_PATH:
-                //createPath(i.writable, i.parameter);
+                //createPath(i.writable, i.get< O::CREATE_PATH >());
                 //break;
             case O::CREATE_DATASET:
-                //createDataset(i.writable, i.parameter);
+                //createDataset(i.writable, i.get< O::CREATE_DATASET >());
                 //break;
             case O::OPEN_FILE:
-                //openFile(i.writable, i.parameter);
+                //openFile(i.writable, i.get< O::OPEN_FILE >());
                 //break;
             case O::OPEN_PATH:
-                //openPath(i.writable, i.parameter);
+                //openPath(i.writable, i.get< O::OPEN_PATH >());
                 //break;
             case O::OPEN_DATASET:
-                //openDataset(i.writable, i.parameter);
+                //openDataset(i.writable, i.get< O::OPEN_DATASET >());
                 //break;
             case O::DELETE_FILE:
-                //deleteFile(i.writable, i.parameter);
+                //deleteFile(i.writable, i.get< O::DELETE_FILE >());
                 //break;
             case O::DELETE_PATH:
-                //deletePath(i.writable, i.parameter);
+                //deletePath(i.writable, i.get< O::DELETE_PATH >());
                 //break;
             case O::DELETE_DATASET:
-                //deleteDataset(i.writable, i.parameter);
+                //deleteDataset(i.writable, i.get< O::DELETE_DATASET >());
                 //break;
             case O::DELETE_ATT:
-                //deleteAttribute(i.writable, i.parameter);
+                //deleteAttribute(i.writable, i.get< O::DELETE_ATT >());
                 //break;
             case O::WRITE_DATASET:
-                //writeDataset(i.writable, i.parameter);
+                //writeDataset(i.writable, i.get< O::WRITE_DATASET >());
                 //break;
             case O::WRITE_ATT:
-                //writeAttribute(i.writable, i.parameter);
+                //writeAttribute(i.writable, i.get< O::WRITE_ATT >());
                 //break;
             case O::READ_DATASET:
-                //readDataset(i.writable, i.parameter);
+                //readDataset(i.writable, i.get< O::READ_DATASET >());
                 //break;
             case O::READ_ATT:
-                //readAttribute(i.writable, i.parameter);
+                //readAttribute(i.writable, i.get< O::READ_ATT >());
                 //break;
             case O::LIST_PATHS:
-                //listPaths(i.writable, i.parameter);
+                //listPaths(i.writable, i.get< O::LIST_PATHS >());
                 //break;
             case O::LIST_DATASETS:
-                //listDatasets(i.writable, i.parameter);
+                //listDatasets(i.writable, i.get< O::LIST_DATASETS >());
                 //break;
             case O::LIST_ATTS:
-                //listAttributes(i.writable, i.parameter);
+                //listAttributes(i.writable, i.get< O::LIST_ATTS >());
                 std::cerr << "Not implemented in ParallelADIOS1 backend yet\n";
                 break;
         }
@@ -143,7 +142,7 @@ ParallelADIOS1IOHandlerImpl::flush()
 }
 
 void ParallelADIOS1IOHandlerImpl::createFile(Writable* writable,
-                                     ArgumentMap const& parameters)
+                                     Parameter< Operation::CREATE_FILE > const& parameters)
 {
     if( !writable->written )
     {
@@ -153,7 +152,7 @@ void ParallelADIOS1IOHandlerImpl::createFile(Writable* writable,
             create_directories(dir);
 
         /* Create a new file. */
-        std::string name = m_handler->directory + parameters.at("name").get< std::string >();
+        std::string name = m_handler->directory + parameters.name;
         if( !ends_with(name, ".bp") )
             name += ".bp";
         int64_t file;
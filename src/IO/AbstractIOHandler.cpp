@@ -21,6 +21,7 @@
 #include <iostream>
 
 #include "IO/AbstractIOHandler.hpp"
+#include "IO/AsyncIOHandler.hpp"
 #include "IO/HDF5/HDF5IOHandler.hpp"
 #include "IO/HDF5/ParallelHDF5IOHandler.hpp"
 
@@ -28,7 +29,8 @@
 std::shared_ptr< AbstractIOHandler >
 AbstractIOHandler::createIOHandler(std::string const& path,
                                    AccessType at,
-                                   Format f)
+                                   Format f,
+                                   bool asynchronous)
 {
     std::shared_ptr< AbstractIOHandler > ret{nullptr};
     switch( f )
@@ -49,13 +51,18 @@ AbstractIOHandler::createIOHandler(std::string const& path,
             break;
     }
 
+    if( asynchronous )
+        ret = std::make_shared< AsyncIOHandler >(ret);
+
     return ret;
 }
 
 AbstractIOHandler::AbstractIOHandler(std::string const& path,
                                      AccessType at)
         : directory{path},
-          accessType{at}
+          accessType{at},
+          pendingBytes{0},
+          maxPendingBytes{0}
 { }
 
 AbstractIOHandler::~AbstractIOHandler()
@@ -67,6 +74,31 @@ AbstractIOHandler::enqueue(IOTask const& i)
     m_work.push(i);
 }
 
+std::future< void >
+AbstractIOHandler::flushAsynchronously()
+{
+    flush();
+    std::promise< void > done;
+    done.set_value();
+    return done.get_future();
+}
+
+void
+AbstractIOHandler::wait()
+{ }
+
+void
+AbstractIOHandler::setMaxOpenFiles(size_t)
+{ }
+
+void
+AbstractIOHandler::setCompressionThreads(unsigned int)
+{ }
+
+void
+AbstractIOHandler::setFileTuning(FileTuning const&)
+{ }
+
 DummyIOHandler::DummyIOHandler(std::string const& path, AccessType at)
         : AbstractIOHandler(path, at)
 { }
@@ -0,0 +1,204 @@
+/* Copyright 2017 Fabian Koller
+ *
+ * This file is part of libopenPMD.
+ *
+ * libopenPMD is free software: you can redistribute it and/or modify
+ * it under the terms of of either the GNU General Public License or
+ * the GNU Lesser General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * libopenPMD is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License and the GNU Lesser General Public License
+ * for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * and the GNU Lesser General Public License along with libopenPMD.
+ * If not, see <http://www.gnu.org/licenses/>.
+ */
+#include "IO/AsyncIOHandler.hpp"
+
+
+AsyncIOHandler::AsyncIOHandler(std::shared_ptr< AbstractIOHandler > backend)
+        : AbstractIOHandler(backend->directory, backend->accessType),
+          m_backend{std::move(backend)},
+          m_busy{false},
+          m_shutdown{false},
+          m_worker{&AsyncIOHandler::run, this}
+{ }
+
+AsyncIOHandler::~AsyncIOHandler()
+{
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        m_shutdown = true;
+    }
+    m_submitted.notify_one();
+    m_worker.join();
+}
+
+std::future< void >
+AsyncIOHandler::flush()
+{
+    flushAsynchronously().get();
+    std::promise< void > done;
+    done.set_value();
+    return done.get_future();
+}
+
+namespace
+{
+/** @return true if the operation may be executed before writes of dataset contents enqueued ahead of it. */
+bool
+precedesWrites(Operation op)
+{
+    switch( op )
+    {
+        using O = Operation;
+        case O::CREATE_PATH:
+        case O::OPEN_PATH:
+        case O::CREATE_DATASET:
+        case O::EXTEND_DATASET:
+        case O::OPEN_DATASET:
+        case O::WRITE_ATT:
+        case O::DELETE_ATT:
+        case O::READ_ATT:
+        case O::LIST_PATHS:
+        case O::LIST_DATASETS:
+        case O::LIST_ATTS:
+        case O::READ_ALL_ATTS:
+            return true;
+        default:
+            return false;
+    }
+}
+} //namespace
+
+std::future< void >
+AsyncIOHandler::flushAsynchronously()
+{
+    /* Only writes of dataset contents are executed on the IO thread.
+     * All other operations update the Writables of the frontend (e.g. their file position),
+     * so they are executed on the calling thread while the IO thread is idle. */
+    wait();
+
+    Batch b;
+    std::future< void > ret = b.done.get_future();
+    try
+    {
+        while( !m_work.empty() )
+        {
+            IOTask& task = m_work.front();
+            if( task.operation == Operation::WRITE_DATASET )
+                b.work.push(std::move(task));
+            else
+            {
+                if( !b.work.empty() && !precedesWrites(task.operation) )
+                {
+                    /* e.g. deleting or closing must not overtake writes enqueued before */
+                    m_backend->flush();
+                    Batch writes;
+                    std::swap(writes.work, b.work);
+                    std::future< void > written = writes.done.get_future();
+                    submit(std::move(writes));
+                    written.get();
+                }
+                m_backend->m_work.push(std::move(task));
+            }
+            m_work.pop();
+        }
+        m_backend->flush();
+    } catch( ... )
+    {
+        /* operations following a failed one are discarded with it */
+        m_work = std::queue< IOTask >();
+        m_backend->m_work = std::queue< IOTask >();
+        b.done.set_exception(std::current_exception());
+        return ret;
+    }
+
+    submit(std::move(b));
+    return ret;
+}
+
+void
+AsyncIOHandler::submit(Batch b)
+{
+    {
+        std::lock_guard< std::mutex > lock(m_mutex);
+        m_batches.push_back(std::move(b));
+    }
+    m_submitted.notify_one();
+}
+
+void
+AsyncIOHandler::wait()
+{
+    waitIdle();
+}
+
+std::unique_lock< std::mutex >
+AsyncIOHandler::waitIdle()
+{
+    std::unique_lock< std::mutex > lock(m_mutex);
+    m_completed.wait(lock, [this]{ return m_batches.empty() && !m_busy; });
+    return lock;
+}
+
+void
+AsyncIOHandler::setMaxOpenFiles(size_t maxOpenFiles)
+{
+    /* the IO thread only accesses the backend while it processes a batch */
+    std::unique_lock< std::mutex > lock = waitIdle();
+    m_backend->setMaxOpenFiles(maxOpenFiles);
+}
+
+void
+AsyncIOHandler::setCompressionThreads(unsigned int numThreads)
+{
+    std::unique_lock< std::mutex > lock = waitIdle();
+    m_backend->setCompressionThreads(numThreads);
+}
+
+void
+AsyncIOHandler::setFileTuning(FileTuning const& tuning)
+{
+    std::unique_lock< std::mutex > lock = waitIdle();
+    m_backend->setFileTuning(tuning);
+}
+
+void
+AsyncIOHandler::run()
+{
+    while( true )
+    {
+        std::unique_lock< std::mutex > lock(m_mutex);
+        m_submitted.wait(lock, [this]{ return !m_batches.empty() || m_shutdown; });
+        if( m_batches.empty() )
+            return;
+
+        Batch b = std::move(m_batches.front());
+        m_batches.pop_front();
+        m_busy = true;
+        lock.unlock();
+
+        try
+        {
+            std::swap(m_backend->m_work, b.work);
+            m_backend->flush();
+            b.done.set_value();
+        } catch( ... )
+        {
+            /* operations following a failed one are discarded with it */
+            m_backend->m_work = std::queue< IOTask >();
+            b.done.set_exception(std::current_exception());
+        }
+
+        lock.lock();
+        m_busy = false;
+        lock.unlock();
+        m_completed.notify_all();
+    }
+}
@@ -1,13 +1,19 @@
 #include <IO/HDF5/HDF5IOHandler.hpp>
 #ifdef LIBOPENPMD_WITH_HDF5
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <map>
+#include <vector>
 
 #include <boost/filesystem.hpp>
 
+#include <auxiliary/Memory.hpp>
 #include <auxiliary/StringManip.hpp>
 #include <backend/Attribute.hpp>
 #include <IO/IOTask.hpp>
 #include <IO/HDF5/HDF5Auxiliary.hpp>
+#include <IO/HDF5/HDF5ChunkCodec.hpp>
 #include <IO/HDF5/HDF5FilePosition.hpp>
 
 
@@ -32,8 +38,28 @@ HDF5IOHandler::flush()
     return m_impl->flush();
 }
 
+void
+HDF5IOHandler::setMaxOpenFiles(size_t maxOpenFiles)
+{
+    /* files exceeding the new limit are evicted on the next access */
+    m_impl->m_maxOpenFiles = maxOpenFiles;
+}
+
+void
+HDF5IOHandler::setCompressionThreads(unsigned int numThreads)
+{
+    m_impl->m_chunkWorkers.resize(numThreads);
+}
+
+void
+HDF5IOHandler::setFileTuning(FileTuning const& tuning)
+{
+    m_impl->m_fileTuning = tuning;
+}
+
 HDF5IOHandlerImpl::HDF5IOHandlerImpl(AbstractIOHandler* handler)
-        : m_datasetTransferProperty{H5P_DEFAULT},
+        : m_maxOpenFiles{0},
+          m_datasetTransferProperty{H5P_DEFAULT},
           m_fileAccessProperty{H5P_DEFAULT},
           m_H5T_BOOL_ENUM{H5Tenum_create(H5T_NATIVE_INT8)},
           m_handler{handler}
@@ -55,19 +81,25 @@ HDF5IOHandlerImpl::~HDF5IOHandlerImpl()
     status = H5Tclose(m_H5T_BOOL_ENUM);
     if( status != 0 )
         std::cerr << "Internal error: Failed to close HDF5 enum\n";
-    while( !m_openFileIDs.empty() )
+    for( auto const& object : m_objects )
     {
-        auto file = m_openFileIDs.begin();
-        status = H5Fclose(*file);
+        status = H5Oclose(object.second.id);
         if( status != 0 )
-            std::cerr << "Internal error: Failed to close HDF5 file\n";
-        m_openFileIDs.erase(file);
+            std::cerr << "Internal error: Failed to close HDF5 object\n";
+    }
+    for( size_t index : m_fileUsage )
+    {
+        status = H5Fclose(m_files[index].id);
+        if( status != 0 )
+            std::cerr << "Internal error: Failed to close HDF5 file " << m_files[index].name << '\n';
     }
 }
 
 std::future< void >
 HDF5IOHandlerImpl::flush()
 {
+    coalesceWrites();
+
     while( !(*m_handler).m_work.empty() )
     {
         IOTask& i = (*m_handler).m_work.front();
@@ -77,58 +109,64 @@ HDF5IOHandlerImpl::flush()
             {
                 using O = Operation;
                 case O::CREATE_FILE:
-                    createFile(i.writable, i.parameter);
+                    createFile(i.writable, i.get< O::CREATE_FILE >());
                     break;
                 case O::CREATE_PATH:
-                    createPath(i.writable, i.parameter);
+                    createPath(i.writable, i.get< O::CREATE_PATH >());
                     break;
                 case O::CREATE_DATASET:
-                    createDataset(i.writable, i.parameter);
+                    createDataset(i.writable, i.get< O::CREATE_DATASET >());
                     break;
                 case O::EXTEND_DATASET:
-                    extendDataset(i.writable, i.parameter);
+                    extendDataset(i.writable, i.get< O::EXTEND_DATASET >());
                     break;
                 case O::OPEN_FILE:
-                    openFile(i.writable, i.parameter);
+                    openFile(i.writable, i.get< O::OPEN_FILE >());
+                    break;
+                case O::CLOSE_FILE:
+                    closeFile(i.writable, i.get< O::CLOSE_FILE >());
                     break;
                 case O::OPEN_PATH:
-                    openPath(i.writable, i.parameter);
+                    openPath(i.writable, i.get< O::OPEN_PATH >());
                     break;
                 case O::OPEN_DATASET:
-                    openDataset(i.writable, i.parameter);
+                    openDataset(i.writable, i.get< O::OPEN_DATASET >());
                     break;
                 case O::DELETE_FILE:
-                    deleteFile(i.writable, i.parameter);
+                    deleteFile(i.writable, i.get< O::DELETE_FILE >());
                     break;
                 case O::DELETE_PATH:
-                    deletePath(i.writable, i.parameter);
+                    deletePath(i.writable, i.get< O::DELETE_PATH >());
                     break;
                 case O::DELETE_DATASET:
-                    deleteDataset(i.writable, i.parameter);
+                    deleteDataset(i.writable, i.get< O::DELETE_DATASET >());
                     break;
                 case O::DELETE_ATT:
-                    deleteAttribute(i.writable, i.parameter);
+                    deleteAttribute(i.writable, i.get< O::DELETE_ATT >());
                     break;
                 case O::WRITE_DATASET:
-                    writeDataset(i.writable, i.parameter);
+                    writeDataset(i.writable, i.get< O::WRITE_DATASET >());
                     break;
                 case O::WRITE_ATT:
-                    writeAttribute(i.writable, i.parameter);
+                    writeAttribute(i.writable, i.get< O::WRITE_ATT >());
                     break;
                 case O::READ_DATASET:
-                    readDataset(i.writable, i.parameter);
+                    readDataset(i.writable, i.get< O::READ_DATASET >());
                     break;
                 case O::READ_ATT:
-                    readAttribute(i.writable, i.parameter);
+                    readAttribute(i.writable, i.get< O::READ_ATT >());
                     break;
                 case O::LIST_PATHS:
-                    listPaths(i.writable, i.parameter);
+                    listPaths(i.writable, i.get< O::LIST_PATHS >());
                     break;
                 case O::LIST_DATASETS:
-                    listDatasets(i.writable, i.parameter);
+                    listDatasets(i.writable, i.get< O::LIST_DATASETS >());
                     break;
                 case O::LIST_ATTS:
-                    listAttributes(i.writable, i.parameter);
+                    listAttributes(i.writable, i.get< O::LIST_ATTS >());
+                    break;
+                case O::READ_ALL_ATTS:
+                    readAllAttributes(i.writable, i.get< O::READ_ALL_ATTS >());
                     break;
             }
         } catch (unsupported_data_error& e)
@@ -138,12 +176,362 @@ HDF5IOHandlerImpl::flush()
         }
         (*m_handler).m_work.pop();
     }
+
+    /* Writables might be destroyed before the next flush */
+    m_positions.clear();
     return std::future< void >();
 }
 
+void
+HDF5IOHandlerImpl::coalesceWrites()
+{
+    using WriteParameter = Parameter< Operation::WRITE_DATASET >;
+
+    std::queue< IOTask >& work = (*m_handler).m_work;
+    std::queue< IOTask > planned;
+    while( !work.empty() )
+    {
+        if( work.front().operation != Operation::WRITE_DATASET )
+        {
+            planned.push(work.front());
+            work.pop();
+            continue;
+        }
+
+        std::vector< IOTask > run{work.front()};
+        work.pop();
+        Writable* writable = run.front().writable;
+        WriteParameter const& first = run.front().get< Operation::WRITE_DATASET >();
+
+        size_t elementSize = 0;
+        switch( first.dtype )
+        {
+            using DT = Datatype;
+            case DT::DOUBLE:
+            case DT::FLOAT:
+            case DT::INT16:
+            case DT::INT32:
+            case DT::INT64:
+            case DT::UINT16:
+            case DT::UINT32:
+            case DT::UINT64:
+            case DT::CHAR:
+            case DT::UCHAR:
+            case DT::BOOL:
+            {
+                Attribute a(0);
+                a.dtype = first.dtype;
+                elementSize = H5Tget_size(getH5DataType(a));
+                break;
+            }
+            default:
+                /* unsupported types are reported during the write itself */
+                break;
+        }
+        /* chunks placed inside larger buffers are selected in memory directly */
+        if( !first.layout.dense() )
+            elementSize = 0;
+
+        /* bounding box of all chunks in the current run */
+        Offset boxOffset = first.offset;
+        Extent boxExtent = first.extent;
+        while( elementSize > 0 && !work.empty() )
+        {
+            IOTask const& next = work.front();
+            if( next.operation != Operation::WRITE_DATASET || next.writable != writable )
+                break;
+            WriteParameter const& chunk = next.get< Operation::WRITE_DATASET >();
+            if( chunk.dtype != first.dtype || chunk.offset.size() != boxOffset.size() || !chunk.layout.dense() )
+                break;
+
+            /* the union of two hyperslabs is a hyperslab if they coincide in
+             * all but one dimension and touch or overlap in the remaining one */
+            size_t const rank = boxOffset.size();
+            size_t differing = rank;
+            bool mergeable = true;
+            for( size_t k = 0; k < rank && mergeable; ++k )
+            {
+                if( chunk.offset[k] == boxOffset[k] && chunk.extent[k] == boxExtent[k] )
+                    continue;
+                if( differing != rank )
+                    mergeable = false;
+                differing = k;
+            }
+            if( !mergeable )
+                break;
+
+            Offset unionOffset = boxOffset;
+            Extent unionExtent = boxExtent;
+            if( differing != rank )
+            {
+                uint64_t const boxEnd = boxOffset[differing] + boxExtent[differing];
+                uint64_t const chunkEnd = chunk.offset[differing] + chunk.extent[differing];
+                if( chunk.offset[differing] > boxEnd || chunkEnd < boxOffset[differing] )
+                    break;
+                unionOffset[differing] = std::min(boxOffset[differing], chunk.offset[differing]);
+                unionExtent[differing] = std::max(boxEnd, chunkEnd) - unionOffset[differing];
+            }
+
+            size_t numBytes = elementSize;
+            for( auto const& val : unionExtent )
+                numBytes *= val;
+            if( numBytes > MAX_COALESCED_BYTES )
+                break;
+
+            boxOffset = unionOffset;
+            boxExtent = unionExtent;
+            run.push_back(next);
+            work.pop();
+        }
+
+        if( run.size() == 1 )
+        {
+            planned.push(run.front());
+            continue;
+        }
+
+        size_t numBytes = elementSize;
+        for( auto const& val : boxExtent )
+            numBytes *= val;
+        std::shared_ptr< char > staging(new char[numBytes], [](char* p){ delete[] p; });
+        for( auto const& task : run )
+        {
+            WriteParameter const& chunk = task.get< Operation::WRITE_DATASET >();
+            Offset relative(chunk.offset.size());
+            for( size_t k = 0; k < relative.size(); ++k )
+                relative[k] = chunk.offset[k] - boxOffset[k];
+            copyChunkIntoBox(staging.get(), boxExtent, relative, chunk.data.get(), chunk.extent, elementSize);
+        }
+
+        WriteParameter merged;
+        merged.offset = boxOffset;
+        merged.extent = boxExtent;
+        merged.dtype = first.dtype;
+        merged.data = std::static_pointer_cast< void >(staging);
+        planned.push(IOTask(writable, merged));
+    }
+    std::swap(work, planned);
+}
+
+std::string const&
+HDF5IOHandlerImpl::position(Writable* writable)
+{
+    auto cached = m_positions.find(writable);
+    if( cached == m_positions.end() )
+        cached = m_positions.insert({writable, concrete_h5_file_position(writable)}).first;
+    return cached->second;
+}
+
+void
+HDF5IOHandlerImpl::forgetPositions(Writable* writable)
+{
+    /* positions of descendants include the position of the deleted object */
+    for( auto it = m_positions.begin(); it != m_positions.end(); )
+    {
+        Writable* w = it->first;
+        while( w && w != writable )
+            w = w->parent;
+        if( w )
+            it = m_positions.erase(it);
+        else
+            ++it;
+    }
+}
+
+hid_t
+HDF5IOHandlerImpl::openObject(size_t index, Writable* writable)
+{
+    std::string path = position(writable);
+    if( path.size() > 1 && ends_with(path, "/") )
+        path.pop_back();
+
+    /* an evicted file closes all cached objects in it, hence it is re-opened first */
+    hid_t file_id = file(index);
+
+    ObjectKey key{index, path};
+    auto cached = m_objects.find(key);
+    if( cached != m_objects.end() )
+    {
+        m_objectUsage.splice(m_objectUsage.begin(), m_objectUsage, cached->second.use);
+        return cached->second.id;
+    }
+
+    hid_t id = H5Oopen(file_id, path.c_str(), H5P_DEFAULT);
+    if( id < 0 )
+        return id;
+
+    if( m_objects.size() >= MAX_CACHED_HANDLES )
+    {
+        auto evicted = m_objects.find(m_objectUsage.back());
+        herr_t status = H5Oclose(evicted->second.id);
+        ASSERT(status == 0, "Internal error: Failed to close HDF5 object " + evicted->first.second + " during handle eviction");
+        m_objects.erase(evicted);
+        m_objectUsage.pop_back();
+    }
+    m_objectUsage.push_front(key);
+    m_objects.insert({key, CachedObject{id, m_objectUsage.begin()}});
+    return id;
+}
+
+void
+HDF5IOHandlerImpl::closeObjects(size_t file, std::string const& path)
+{
+    std::string prefix = path;
+    if( !ends_with(prefix, "/") )
+        prefix += '/';
+
+    auto it = m_objects.begin();
+    while( it != m_objects.end() )
+    {
+        std::string const& p = it->first.second;
+        if( it->first.first == file && (p + '/' == prefix || starts_with(p, prefix) || prefix == "/") )
+        {
+            herr_t status = H5Oclose(it->second.id);
+            ASSERT(status == 0, "Internal error: Failed to close HDF5 object " + p);
+            m_objectUsage.erase(it->second.use);
+            it = m_objects.erase(it);
+        } else
+            ++it;
+    }
+}
+
+size_t
+HDF5IOHandlerImpl::fileIndex(std::string const& name)
+{
+    auto known = m_fileIndices.find(name);
+    if( known != m_fileIndices.end() )
+        return known->second;
+
+    m_files.push_back(File{name, -1, m_fileUsage.end()});
+    m_fileIndices.insert({name, m_files.size() - 1});
+    return m_files.size() - 1;
+}
+
+hid_t
+HDF5IOHandlerImpl::file(size_t index)
+{
+    if( m_files[index].id < 0 )
+    {
+        if( m_files[index].name.empty() )
+            throw std::runtime_error("Internal error: Access to a deleted HDF5 file");
+
+        unsigned flags;
+        AccessType at = m_handler->accessType;
+        if( at == AccessType::READ_ONLY )
+            flags = H5F_ACC_RDONLY;
+        else if( at == AccessType::READ_WRITE || at == AccessType::CREATE )
+            flags = H5F_ACC_RDWR;
+        else
+            throw std::runtime_error("Unknown file AccessType");
+        hid_t fileAccess = fileAccessProperty();
+        hid_t file_id = H5Fopen(m_files[index].name.c_str(),
+                                flags,
+                                fileAccess);
+        H5Pclose(fileAccess);
+        if( file_id < 0 )
+            throw no_such_file_error("Failed to open HDF5 file " + m_files[index].name);
+        m_files[index].id = file_id;
+    }
+
+    useFile(index);
+    return m_files[index].id;
+}
+
+hid_t
+HDF5IOHandlerImpl::fileAccessProperty()
+{
+    /* copy to keep the settings of derived handlers, e.g. the MPI-IO driver */
+    hid_t fileAccess = m_fileAccessProperty == H5P_DEFAULT ? H5Pcreate(H5P_FILE_ACCESS) : H5Pcopy(m_fileAccessProperty);
+    FileTuning const& t = m_fileTuning;
+    herr_t status;
+    if( t.alignment > 1 )
+    {
+        status = H5Pset_alignment(fileAccess, t.alignmentThreshold, t.alignment);
+        ASSERT(status == 0, "Internal error: Failed to set HDF5 file alignment");
+    }
+    if( t.metaBlockSize > 0 )
+    {
+        status = H5Pset_meta_block_size(fileAccess, t.metaBlockSize);
+        ASSERT(status == 0, "Internal error: Failed to set HDF5 metadata block size");
+    }
+    if( t.metadataCacheSize > 0 )
+    {
+        H5AC_cache_config_t config;
+        config.version = H5AC__CURR_CACHE_CONFIG_VERSION;
+        status = H5Pget_mdc_config(fileAccess, &config);
+        ASSERT(status == 0, "Internal error: Failed to get HDF5 metadata cache configuration");
+        config.set_initial_size = true;
+        config.initial_size = t.metadataCacheSize;
+        config.max_size = std::max(config.max_size, t.metadataCacheSize);
+        config.min_size = std::min(config.min_size, t.metadataCacheSize);
+        status = H5Pset_mdc_config(fileAccess, &config);
+        ASSERT(status == 0, "Internal error: Failed to set HDF5 metadata cache configuration");
+    }
+    if( t.formatVersion != FileTuning::FormatVersion::EARLIEST )
+    {
+        H5F_libver_t low = H5F_LIBVER_LATEST;
+#if H5_VERSION_GE(1, 10, 2)
+        if( t.formatVersion == FileTuning::FormatVersion::V18 )
+            low = H5F_LIBVER_V18;
+        else if( t.formatVersion == FileTuning::FormatVersion::V110 )
+            low = H5F_LIBVER_V110;
+#endif
+        status = H5Pset_libver_bounds(fileAccess, low, H5F_LIBVER_LATEST);
+        ASSERT(status == 0, "Internal error: Failed to set HDF5 file format version");
+    }
+    return fileAccess;
+}
+
+hid_t
+HDF5IOHandlerImpl::fileCreationProperty()
+{
+    hid_t fileCreation = H5Pcreate(H5P_FILE_CREATE);
+#if H5_VERSION_GE(1, 10, 1)
+    if( m_fileTuning.pageSize > 0 )
+    {
+        herr_t status;
+        status = H5Pset_file_space_strategy(fileCreation, H5F_FSPACE_STRATEGY_PAGE, 0, 1);
+        ASSERT(status == 0, "Internal error: Failed to set HDF5 file space strategy");
+        status = H5Pset_file_space_page_size(fileCreation, m_fileTuning.pageSize);
+        ASSERT(status == 0, "Internal error: Failed to set HDF5 file space page size");
+    }
+#endif
+    return fileCreation;
+}
+
+void
+HDF5IOHandlerImpl::useFile(size_t index)
+{
+    File& f = m_files[index];
+    if( f.use == m_fileUsage.end() )
+    {
+        m_fileUsage.push_front(index);
+        f.use = m_fileUsage.begin();
+    } else
+        m_fileUsage.splice(m_fileUsage.begin(), m_fileUsage, f.use);
+
+    while( m_maxOpenFiles > 0 && m_fileUsage.size() > m_maxOpenFiles )
+        closeFile(m_fileUsage.back());
+}
+
+void
+HDF5IOHandlerImpl::closeFile(size_t index)
+{
+    File& f = m_files[index];
+    if( f.id < 0 )
+        return;
+
+    closeObjects(index, "/");
+    herr_t status = H5Fclose(f.id);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 file " + f.name);
+    f.id = -1;
+    m_fileUsage.erase(f.use);
+    f.use = m_fileUsage.end();
+}
+
 void
 HDF5IOHandlerImpl::createFile(Writable* writable,
-                              ArgumentMap const& parameters)
+                              Parameter< Operation::CREATE_FILE > const& parameters)
 {
     if( !writable->written )
     {
@@ -153,31 +541,38 @@ HDF5IOHandlerImpl::createFile(Writable* writable,
             create_directories(dir);
 
         /* Create a new file using current properties. */
-        std::string name = m_handler->directory + parameters.at("name").get< std::string >();
+        std::string name = m_handler->directory + parameters.name;
         if( !ends_with(name, ".h5") )
             name += ".h5";
+        size_t index = fileIndex(name);
+        closeFile(index);
+        hid_t fileCreation = fileCreationProperty();
+        hid_t fileAccess = fileAccessProperty();
         hid_t id = H5Fcreate(name.c_str(),
                              H5F_ACC_TRUNC,
-                             H5P_DEFAULT,
-                             m_fileAccessProperty);
+                             fileCreation,
+                             fileAccess);
         ASSERT(id >= 0, "Internal error: Failed to create HDF5 file");
+        H5Pclose(fileCreation);
+        H5Pclose(fileAccess);
+        m_files[index].id = id;
+        useFile(index);
 
         writable->written = true;
         writable->abstractFilePosition = std::make_shared< HDF5FilePosition >("/");
 
-        m_fileIDs[writable] = id;
-        m_openFileIDs.insert(id);
+        m_fileIDs[writable] = index;
     }
 }
 
 void
 HDF5IOHandlerImpl::createPath(Writable* writable,
-                              ArgumentMap const& parameters)
+                              Parameter< Operation::CREATE_PATH > const& parameters)
 {
     if( !writable->written )
     {
         /* Sanitize path */
-        std::string path = parameters.at("path").get< std::string >();
+        std::string path = parameters.path;
         if( starts_with(path, "/") )
             path = replace_first(path, "/", "");
         if( !ends_with(path, "/") )
@@ -190,9 +585,7 @@ HDF5IOHandlerImpl::createPath(Writable* writable,
         else
             position = writable; /* root does not have a parent but might still have to be written */
         auto res = m_fileIDs.find(position);
-        hid_t node_id = H5Gopen(res->second,
-                                concrete_h5_file_position(position).c_str(),
-                                H5P_DEFAULT);
+        hid_t node_id = openObject(res->second, position);
         ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during path creation");
 
         /* Create the path in the file */
@@ -209,9 +602,9 @@ HDF5IOHandlerImpl::createPath(Writable* writable,
             groups.push(group_id);
         }
 
-        /* Close the groups */
+        /* Close the created groups, the opened node is owned by the handle cache */
         herr_t status;
-        while( !groups.empty() )
+        while( groups.size() > 1 )
         {
             status = H5Gclose(groups.top());
             ASSERT(status == 0, "Internal error: Failed to close HDF5 group during path creation");
@@ -220,6 +613,7 @@ HDF5IOHandlerImpl::createPath(Writable* writable,
 
         writable->written = true;
         writable->abstractFilePosition = std::make_shared< HDF5FilePosition >(path);
+        m_positions.erase(writable);
 
         m_fileIDs[writable] = res->second;
     }
@@ -227,11 +621,11 @@ HDF5IOHandlerImpl::createPath(Writable* writable,
 
 void
 HDF5IOHandlerImpl::createDataset(Writable* writable,
-                                 ArgumentMap const& parameters)
+                                 Parameter< Operation::CREATE_DATASET > const& parameters)
 {
     if( !writable->written )
     {
-        std::string name = parameters.at("name").get< std::string >();
+        std::string name = parameters.name;
         if( starts_with(name, "/") )
             name = replace_first(name, "/", "");
         if( ends_with(name, "/") )
@@ -242,12 +636,10 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
         auto res = m_fileIDs.find(writable);
         if( res == m_fileIDs.end() )
             res = m_fileIDs.find(writable->parent);
-        hid_t node_id = H5Gopen(res->second,
-                                concrete_h5_file_position(writable).c_str(),
-                                H5P_DEFAULT);
+        hid_t node_id = openObject(res->second, writable);
         ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset creation");
 
-        Datatype d = parameters.at("dtype").get< Datatype >();
+        Datatype d = parameters.dtype;
         if( d == Datatype::UNDEFINED )
         {
             // TODO handle unknown dtype
@@ -258,25 +650,56 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
         a.dtype = d;
         std::vector< hsize_t > dims;
         std::vector< hsize_t > maxdims;
-        for( auto const& val : parameters.at("extent").get< Extent >() )
+        for( auto const& val : parameters.extent )
         {
             dims.push_back(static_cast< hsize_t >(val));
             maxdims.push_back(H5S_UNLIMITED);
         }
 
-        hid_t space = H5Screate_simple(dims.size(), dims.data(), maxdims.data());
+        using L = Dataset::Layout;
+        bool const chunked = parameters.layout == L::CHUNKED;
+        if( !chunked && (!parameters.filters.empty() || !parameters.compression.empty()) )
+            throw std::runtime_error("Filtered HDF5 datasets require a chunked layout");
 
-        std::vector< hsize_t > chunkDims;
-        for( auto const& val : parameters.at("chunkSize").get< Extent >() )
-            chunkDims.push_back(static_cast< hsize_t >(val));
+        /* only chunked datasets can grow */
+        hid_t space = H5Screate_simple(dims.size(), dims.data(), chunked ? maxdims.data() : nullptr);
 
-        /* enable chunking on the created dataspace */
         hid_t datasetCreationProperty = H5Pcreate(H5P_DATASET_CREATE);
         herr_t status;
-        status = H5Pset_chunk(datasetCreationProperty, chunkDims.size(), chunkDims.data());
-        ASSERT(status == 0, "Internal error: Failed to set chunk size during dataset creation");
+        if( chunked )
+        {
+            std::vector< hsize_t > chunkDims;
+            for( auto const& val : parameters.chunkSize )
+                chunkDims.push_back(static_cast< hsize_t >(val));
 
-        std::string const& compression = parameters.at("compression").get< std::string >();
+            status = H5Pset_chunk(datasetCreationProperty, chunkDims.size(), chunkDims.data());
+            ASSERT(status == 0, "Internal error: Failed to set chunk size during dataset creation");
+        } else
+        {
+            status = H5Pset_layout(datasetCreationProperty, parameters.layout == L::COMPACT ? H5D_COMPACT : H5D_CONTIGUOUS);
+            ASSERT(status == 0, "Internal error: Failed to set layout during dataset creation");
+        }
+
+        using FT = Dataset::FillTime;
+        if( parameters.fillTime != FT::DEFAULT )
+        {
+            status = H5Pset_fill_time(datasetCreationProperty,
+                                      parameters.fillTime == FT::ALWAYS ? H5D_FILL_TIME_ALLOC : H5D_FILL_TIME_NEVER);
+            ASSERT(status == 0, "Internal error: Failed to set fill time during dataset creation");
+        }
+        using AT = Dataset::AllocationTime;
+        if( parameters.allocationTime != AT::DEFAULT )
+        {
+            H5D_alloc_time_t allocTime = H5D_ALLOC_TIME_INCR;
+            if( parameters.allocationTime == AT::EARLY )
+                allocTime = H5D_ALLOC_TIME_EARLY;
+            else if( parameters.allocationTime == AT::LATE )
+                allocTime = H5D_ALLOC_TIME_LATE;
+            status = H5Pset_alloc_time(datasetCreationProperty, allocTime);
+            ASSERT(status == 0, "Internal error: Failed to set allocation time during dataset creation");
+        }
+
+        std::string const& compression = parameters.compression;
         if( !compression.empty() )
         {
             std::vector< std::string > args = split(compression, ":");
@@ -296,7 +719,55 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
                           << std::endl;
         }
 
-        std::string const& transform = parameters.at("transform").get< std::string >();
+        for( auto const& filter : parameters.filters )
+        {
+            /* filters not built into the library are loaded from plugins on demand,
+             * built-in ones may be missing or only able to decode (e.g. szip) */
+            unsigned int config = 0;
+            bool const available = H5Zfilter_avail(filter.id) > 0
+                                   && H5Zget_filter_info(filter.id, &config) >= 0
+                                   && (config & H5Z_FILTER_CONFIG_ENCODE_ENABLED) != 0;
+            if( !available )
+            {
+                if( !filter.optional )
+                    throw std::runtime_error("HDF5 filter " + std::to_string(filter.id) + " is not available for writing");
+                std::cerr << "HDF5 filter " << filter.id
+                          << " is not available for writing. Data will not be filtered by it!"
+                          << std::endl;
+                continue;
+            }
+
+            unsigned int const flags = filter.optional ? H5Z_FLAG_OPTIONAL : H5Z_FLAG_MANDATORY;
+            switch( filter.id )
+            {
+                case H5Z_FILTER_SHUFFLE:
+                    status = H5Pset_shuffle(datasetCreationProperty);
+                    break;
+                case H5Z_FILTER_FLETCHER32:
+                    status = H5Pset_fletcher32(datasetCreationProperty);
+                    break;
+                case H5Z_FILTER_SZIP:
+                    status = H5Pset_szip(datasetCreationProperty, filter.parameters.at(0), filter.parameters.at(1));
+                    break;
+                default:
+                    status = H5Pset_filter(datasetCreationProperty,
+                                           filter.id,
+                                           flags,
+                                           filter.parameters.size(),
+                                           filter.parameters.data());
+                    break;
+            }
+            if( status < 0 )
+            {
+                if( !filter.optional )
+                    throw std::runtime_error("Failed to add HDF5 filter " + std::to_string(filter.id) + " during dataset creation");
+                std::cerr << "Failed to add HDF5 filter " << filter.id
+                          << ". Data will not be filtered by it!"
+                          << std::endl;
+            }
+        }
+
+        std::string const& transform = parameters.transform;
         if( !transform.empty() )
             std::cerr << "Custom transform not yet implemented in HDF5 backend."
                       << std::endl;
@@ -312,11 +783,14 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
 
         status = H5Dclose(group_id);
         ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset during dataset creation");
-        status = H5Gclose(node_id);
-        ASSERT(status == 0, "Internal error: Failed to close HDF5 group during dataset creation");
+        status = H5Pclose(datasetCreationProperty);
+        ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset creation property during dataset creation");
+        status = H5Sclose(space);
+        ASSERT(status == 0, "Internal error: Failed to close HDF5 dataspace during dataset creation");
 
         writable->written = true;
         writable->abstractFilePosition = std::make_shared< HDF5FilePosition >(name);
+        m_positions.erase(writable);
 
         m_fileIDs[writable] = res->second;
     }
@@ -324,20 +798,18 @@ HDF5IOHandlerImpl::createDataset(Writable* writable,
 
 void
 HDF5IOHandlerImpl::extendDataset(Writable* writable,
-                                 ArgumentMap const& parameters)
+                                 Parameter< Operation::EXTEND_DATASET > const& parameters)
 {
     if( !writable->written )
         throw std::runtime_error("Extending an unwritten Dataset is not possible.");
 
     auto res = m_fileIDs.find(writable->parent);
     hid_t node_id, dataset_id;
-    node_id = H5Gopen(res->second,
-                      concrete_h5_file_position(writable->parent).c_str(),
-                      H5P_DEFAULT);
+    node_id = openObject(res->second, writable->parent);
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset extension");
 
     /* Sanitize name */
-    std::string name = parameters.at("name").get< std::string >();
+    std::string name = parameters.name;
     if( starts_with(name, "/") )
         name = replace_first(name, "/", "");
     if( !ends_with(name, "/") )
@@ -348,72 +820,75 @@ HDF5IOHandlerImpl::extendDataset(Writable* writable,
                          H5P_DEFAULT);
     ASSERT(dataset_id >= 0, "Internal error: Failed to open HDF5 dataset during dataset extension");
 
+    herr_t status;
+    hid_t datasetCreationProperty = H5Dget_create_plist(dataset_id);
+    bool const chunked = H5Pget_layout(datasetCreationProperty) == H5D_CHUNKED;
+    status = H5Pclose(datasetCreationProperty);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset creation property during dataset extension");
+    if( !chunked )
+    {
+        H5Dclose(dataset_id);
+        throw std::runtime_error("Only chunked datasets can be extended");
+    }
+
     std::vector< hsize_t > size;
-    for( auto const& val : parameters.at("extent").get< Extent >() )
+    for( auto const& val : parameters.extent )
         size.push_back(static_cast< hsize_t >(val));
 
-    herr_t status;
     status = H5Dset_extent(dataset_id, size.data());
     ASSERT(status == 0, "Internal error: Failed to extend HDF5 dataset during dataset extension");
 
     status = H5Dclose(dataset_id);
     ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset during dataset extension");
-    status = H5Gclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close HDF5 group during dataset extension");
 }
 
 void
 HDF5IOHandlerImpl::openFile(Writable* writable,
-                            ArgumentMap const& parameters)
+                            Parameter< Operation::OPEN_FILE > const& parameters)
 {
-    //TODO check if file already open
-    //not possible with current implementation
-    //quick idea - map with filenames as key
     using namespace boost::filesystem;
     path dir(m_handler->directory);
     if( !exists(dir) )
         throw std::runtime_error("Supplied directory is not valid");
 
-    std::string name = m_handler->directory + parameters.at("name").get< std::string >();
+    std::string name = m_handler->directory + parameters.name;
     if( !ends_with(name, ".h5") )
         name += ".h5";
 
-    unsigned flags;
-    AccessType at = m_handler->accessType;
-    if( at == AccessType::READ_ONLY )
-        flags = H5F_ACC_RDONLY;
-    else if( at == AccessType::READ_WRITE || at == AccessType::CREATE )
-        flags = H5F_ACC_RDWR;
-    else
-        throw std::runtime_error("Unknown file AccessType");
-    hid_t file_id;
-    file_id = H5Fopen(name.c_str(),
-                      flags,
-                      m_fileAccessProperty);
-    if( file_id < 0 )
-        throw no_such_file_error("Failed to open HDF5 file " + name);
+    /* files that are open already are shared */
+    size_t index = fileIndex(name);
+    file(index);
 
     writable->written = true;
     writable->abstractFilePosition = std::make_shared< HDF5FilePosition >("/");
+    m_positions.erase(writable);
 
     m_fileIDs.erase(writable);
-    m_fileIDs.insert({writable, file_id});
-    m_openFileIDs.insert(file_id);
+    m_fileIDs.insert({writable, index});
+}
+
+void
+HDF5IOHandlerImpl::closeFile(Writable* writable,
+                             Parameter< Operation::CLOSE_FILE > const&)
+{
+    auto res = m_fileIDs.find(writable);
+    if( res == m_fileIDs.end() )
+        res = m_fileIDs.find(writable->parent);
+    if( res != m_fileIDs.end() )
+        closeFile(res->second);
 }
 
 void
 HDF5IOHandlerImpl::openPath(Writable* writable,
-                            ArgumentMap const& parameters)
+                            Parameter< Operation::OPEN_PATH > const& parameters)
 {
     auto res = m_fileIDs.find(writable->parent);
     hid_t node_id, path_id;
-    node_id = H5Gopen(res->second,
-                      concrete_h5_file_position(writable->parent).c_str(),
-                      H5P_DEFAULT);
+    node_id = openObject(res->second, writable->parent);
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during path opening");
 
     /* Sanitize path */
-    std::string path = parameters.at("path").get< std::string >();
+    std::string path = parameters.path;
     if( starts_with(path, "/") )
         path = replace_first(path, "/", "");
     if( !ends_with(path, "/") )
@@ -427,11 +902,10 @@ HDF5IOHandlerImpl::openPath(Writable* writable,
     herr_t status;
     status = H5Gclose(path_id);
     ASSERT(status == 0, "Internal error: Failed to close HDF5 group during path opening");
-    status = H5Gclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close HDF5 group during path opening");
 
     writable->written = true;
     writable->abstractFilePosition = std::make_shared< HDF5FilePosition >(path);
+    m_positions.erase(writable);
 
     m_fileIDs.erase(writable);
     m_fileIDs.insert({writable, res->second});
@@ -439,17 +913,15 @@ HDF5IOHandlerImpl::openPath(Writable* writable,
 
 void
 HDF5IOHandlerImpl::openDataset(Writable* writable,
-                               std::map< std::string, ParameterArgument > & parameters)
+                               Parameter< Operation::OPEN_DATASET > & parameters)
 {
     auto res = m_fileIDs.find(writable->parent);
     hid_t node_id, dataset_id;
-    node_id = H5Gopen(res->second,
-                      concrete_h5_file_position(writable->parent).c_str(),
-                      H5P_DEFAULT);
+    node_id = openObject(res->second, writable->parent);
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset opening");
 
     /* Sanitize name */
-    std::string name = parameters.at("name").get< std::string >();
+    std::string name = parameters.name;
     if( starts_with(name, "/") )
         name = replace_first(name, "/", "");
     if( !ends_with(name, "/") )
@@ -497,8 +969,7 @@ HDF5IOHandlerImpl::openDataset(Writable* writable,
     } else
         throw std::runtime_error("Unsupported dataset class");
 
-    auto dtype = parameters.at("dtype").get< std::shared_ptr< Datatype > >();
-    *dtype = d;
+    *parameters.dtype = d;
 
     int ndims = H5Sget_simple_extent_ndims(dataset_space);
     std::vector< hsize_t > dims(ndims, 0);
@@ -510,35 +981,61 @@ HDF5IOHandlerImpl::openDataset(Writable* writable,
     Extent e;
     for( auto const& val : dims )
         e.push_back(val);
-    auto extent = parameters.at("extent").get< std::shared_ptr< Extent > >();
-    *extent = e;
+    *parameters.extent = e;
 
+    /* report the filter pipeline the dataset was created with */
     herr_t status;
+    hid_t datasetCreationProperty = H5Dget_create_plist(dataset_id);
+    *parameters.filters = getH5Filters(datasetCreationProperty);
+    parameters.chunkSize->clear();
+    switch( H5Pget_layout(datasetCreationProperty) )
+    {
+        case H5D_COMPACT:
+            *parameters.layout = Dataset::Layout::COMPACT;
+            break;
+        case H5D_CONTIGUOUS:
+            *parameters.layout = Dataset::Layout::CONTIGUOUS;
+            break;
+        case H5D_CHUNKED:
+            *parameters.layout = Dataset::Layout::CHUNKED;
+            break;
+        default:
+            *parameters.layout = Dataset::Layout::DEFAULT;
+            break;
+    }
+    if( *parameters.layout == Dataset::Layout::CHUNKED )
+    {
+        std::vector< hsize_t > chunkDims(e.size());
+        int const chunkRank = H5Pget_chunk(datasetCreationProperty, static_cast< int >(chunkDims.size()), chunkDims.data());
+        if( chunkRank == static_cast< int >(chunkDims.size()) )
+            parameters.chunkSize->assign(chunkDims.begin(), chunkDims.end());
+    }
+    status = H5Pclose(datasetCreationProperty);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset creation property during dataset opening");
+
     status = H5Dclose(dataset_id);
     ASSERT(status == 0, "Internal error: Failed to close HDF5 dataset during dataset opening");
-    status = H5Gclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close HDF5 group during dataset opening");
 
     writable->written = true;
     writable->abstractFilePosition = std::make_shared< HDF5FilePosition >(name);
+    m_positions.erase(writable);
 
     m_fileIDs[writable] = res->second;
 }
 
 void
 HDF5IOHandlerImpl::deleteFile(Writable* writable,
-                              ArgumentMap const& parameters)
+                              Parameter< Operation::DELETE_FILE > const& parameters)
 {
     if( m_handler->accessType == AccessType::READ_ONLY )
         throw std::runtime_error("Deleting a file opened as read only is not possible.");
 
     if( writable->written )
     {
-        hid_t file_id = m_fileIDs[writable];
-        herr_t status = H5Fclose(file_id);
-        ASSERT(status == 0, "Interal error: Failed to close HDF5 file during file deletion");
+        size_t index = m_fileIDs[writable];
+        closeFile(index);
 
-        std::string name = m_handler->directory + parameters.at("name").get< std::string >();
+        std::string name = m_handler->directory + parameters.name;
         if( !ends_with(name, ".h5") )
             name += ".h5";
 
@@ -551,15 +1048,18 @@ HDF5IOHandlerImpl::deleteFile(Writable* writable,
 
         writable->written = false;
         writable->abstractFilePosition.reset();
+        forgetPositions(writable);
 
-        m_openFileIDs.erase(file_id);
+        /* a file created under the same name later on is a different file */
+        m_fileIndices.erase(m_files[index].name);
+        m_files[index].name.clear();
         m_fileIDs.erase(writable);
     }
 }
 
 void
 HDF5IOHandlerImpl::deletePath(Writable* writable,
-                              ArgumentMap const& parameters)
+                              Parameter< Operation::DELETE_PATH > const& parameters)
 {
     if( m_handler->accessType == AccessType::READ_ONLY )
         throw std::runtime_error("Deleting a path in a file opened as read only is not possible.");
@@ -567,7 +1067,7 @@ HDF5IOHandlerImpl::deletePath(Writable* writable,
     if( writable->written )
     {
         /* Sanitize path */
-        std::string path = parameters.at("path").get< std::string >();
+        std::string path = parameters.path;
         if( starts_with(path, "/") )
             path = replace_first(path, "/", "");
         if( !ends_with(path, "/") )
@@ -580,9 +1080,8 @@ HDF5IOHandlerImpl::deletePath(Writable* writable,
         auto res = m_fileIDs.find(writable);
         if( res == m_fileIDs.end() )
             res = m_fileIDs.find(writable->parent);
-        hid_t node_id = H5Gopen(res->second,
-                                concrete_h5_file_position(writable->parent).c_str(),
-                                H5P_DEFAULT);
+        closeObjects(res->second, position(writable));
+        hid_t node_id = openObject(res->second, writable->parent);
         ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during path deletion");
 
         path += static_cast< HDF5FilePosition* >(writable->abstractFilePosition.get())->location;
@@ -591,11 +1090,9 @@ HDF5IOHandlerImpl::deletePath(Writable* writable,
                                   H5P_DEFAULT);
         ASSERT(status == 0, "Internal error: Failed to delete HDF5 group");
 
-        status = H5Gclose(node_id);
-        ASSERT(status == 0, "Internal error: Failed to close HDF5 group during path deletion");
-
         writable->written = false;
         writable->abstractFilePosition.reset();
+        forgetPositions(writable);
 
         m_fileIDs.erase(writable);
     }
@@ -603,7 +1100,7 @@ HDF5IOHandlerImpl::deletePath(Writable* writable,
 
 void
 HDF5IOHandlerImpl::deleteDataset(Writable* writable,
-                                 ArgumentMap const& parameters)
+                                 Parameter< Operation::DELETE_DATASET > const& parameters)
 {
     if( m_handler->accessType == AccessType::READ_ONLY )
         throw std::runtime_error("Deleting a path in a file opened as read only is not possible.");
@@ -611,7 +1108,7 @@ HDF5IOHandlerImpl::deleteDataset(Writable* writable,
     if( writable->written )
     {
         /* Sanitize name */
-        std::string name = parameters.at("name").get< std::string >();
+        std::string name = parameters.name;
         if( starts_with(name, "/") )
             name = replace_first(name, "/", "");
         if( !ends_with(name, "/") )
@@ -624,9 +1121,8 @@ HDF5IOHandlerImpl::deleteDataset(Writable* writable,
         auto res = m_fileIDs.find(writable);
         if( res == m_fileIDs.end() )
             res = m_fileIDs.find(writable->parent);
-        hid_t node_id = H5Gopen(res->second,
-                                concrete_h5_file_position(writable->parent).c_str(),
-                                H5P_DEFAULT);
+        closeObjects(res->second, position(writable));
+        hid_t node_id = openObject(res->second, writable->parent);
         ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset deletion");
 
         name += static_cast< HDF5FilePosition* >(writable->abstractFilePosition.get())->location;
@@ -635,11 +1131,9 @@ HDF5IOHandlerImpl::deleteDataset(Writable* writable,
                                   H5P_DEFAULT);
         ASSERT(status == 0, "Internal error: Failed to delete HDF5 group");
 
-        status = H5Gclose(node_id);
-        ASSERT(status == 0, "Internal error: Failed to close HDF5 group during dataset deletion");
-
         writable->written = false;
         writable->abstractFilePosition.reset();
+        forgetPositions(writable);
 
         m_fileIDs.erase(writable);
     }
@@ -647,36 +1141,31 @@ HDF5IOHandlerImpl::deleteDataset(Writable* writable,
 
 void
 HDF5IOHandlerImpl::deleteAttribute(Writable* writable,
-                                   ArgumentMap const& parameters)
+                                   Parameter< Operation::DELETE_ATT > const& parameters)
 {
     if( m_handler->accessType == AccessType::READ_ONLY )
         throw std::runtime_error("Deleting an attribute in a file opened as read only is not possible.");
 
     if( writable->written )
     {
-        std::string name = parameters.at("name").get< std::string >();
+        std::string name = parameters.name;
 
         /* Open H5Object to delete in */
         auto res = m_fileIDs.find(writable);
         if( res == m_fileIDs.end() )
             res = m_fileIDs.find(writable->parent);
-        hid_t node_id = H5Oopen(res->second,
-                                concrete_h5_file_position(writable).c_str(),
-                                H5P_DEFAULT);
+        hid_t node_id = openObject(res->second, writable);
         ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during attribute deletion");
 
         herr_t status = H5Adelete(node_id,
                                   name.c_str());
         ASSERT(status == 0, "Internal error: Failed to delete HDF5 attribute");
-
-        status = H5Oclose(node_id);
-        ASSERT(status == 0, "Internal error: Failed to close HDF5 group during attribute deletion");
     }
 }
 
 void
 HDF5IOHandlerImpl::writeDataset(Writable* writable,
-                                ArgumentMap const& parameters)
+                                Parameter< Operation::WRITE_DATASET > const& parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
@@ -684,20 +1173,24 @@ HDF5IOHandlerImpl::writeDataset(Writable* writable,
 
     hid_t dataset_id, filespace, memspace;
     herr_t status;
-    dataset_id = H5Dopen(res->second,
-                         concrete_h5_file_position(writable).c_str(),
-                         H5P_DEFAULT);
+    dataset_id = openObject(res->second, writable);
     ASSERT(dataset_id >= 0, "Internal error: Failed to open HDF5 dataset during dataset write");
 
+    if( writeChunksDirectly(dataset_id, parameters) )
+    {
+        m_fileIDs[writable] = res->second;
+        return;
+    }
+
     std::vector< hsize_t > start;
-    for( auto const& val : parameters.at("offset").get< Offset >() )
+    for( auto const& val : parameters.offset )
         start.push_back(static_cast< hsize_t >(val));
     std::vector< hsize_t > stride(start.size(), 1); /* contiguous region */
     std::vector< hsize_t > count(start.size(), 1); /* single region */
     std::vector< hsize_t > block;
-    for( auto const& val : parameters.at("extent").get< Extent >() )
+    for( auto const& val : parameters.extent )
         block.push_back(static_cast< hsize_t >(val));
-    memspace = H5Screate_simple(block.size(), block.data(), nullptr);
+    memspace = getH5MemorySpace(parameters.extent, parameters.layout);
     filespace = H5Dget_space(dataset_id);
     status = H5Sselect_hyperslab(filespace,
                                  H5S_SELECT_SET,
@@ -707,10 +1200,10 @@ HDF5IOHandlerImpl::writeDataset(Writable* writable,
                                  block.data());
     ASSERT(status == 0, "Internal error: Failed to select hyperslab during dataset write");
 
-    std::shared_ptr< void > data = parameters.at("data").get< std::shared_ptr< void > >();
+    std::shared_ptr< void > const& data = parameters.data;
 
     Attribute a(0);
-    a.dtype = parameters.at("dtype").get< Datatype >();
+    a.dtype = parameters.dtype;
     switch( a.dtype )
     {
         using DT = Datatype;
@@ -740,27 +1233,27 @@ HDF5IOHandlerImpl::writeDataset(Writable* writable,
         default:
             throw std::runtime_error("Datatype not implemented in HDF5 IO");
     }
-    status = H5Dclose(dataset_id);
-    ASSERT(status == 0, "Internal error: Failed to close dataset " + concrete_h5_file_position(writable) + " during dataset write");
+    status = H5Sclose(memspace);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 memory dataspace during dataset write");
+    status = H5Sclose(filespace);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 file dataspace during dataset write");
 
     m_fileIDs[writable] = res->second;
 }
 
 void
 HDF5IOHandlerImpl::writeAttribute(Writable* writable,
-                                          ArgumentMap const& parameters)
+                                          Parameter< Operation::WRITE_ATT > const& parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
     hid_t node_id, attribute_id;
-    node_id = H5Oopen(res->second,
-                      concrete_h5_file_position(writable).c_str(),
-                      H5P_DEFAULT);
+    node_id = openObject(res->second, writable);
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 object during attribute write");
-    std::string name = parameters.at("name").get< std::string >();
-    Attribute const att(parameters.at("attribute").get< Attribute::resource >());
-    Datatype dtype = parameters.at("dtype").get< Datatype >();
+    std::string name = parameters.name;
+    Attribute const att(parameters.resource);
+    Datatype dtype = parameters.dtype;
     if( H5Aexists(node_id, name.c_str()) == 0 )
     {
         hid_t dataType;
@@ -946,35 +1439,34 @@ HDF5IOHandlerImpl::writeAttribute(Writable* writable,
 
     status = H5Aclose(attribute_id);
     ASSERT(status == 0, "Internal error: Failed to close attribute " + name + " at " + concrete_h5_file_position(writable) + " during attribute write");
-    status = H5Oclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close " + concrete_h5_file_position(writable) + " during attribute write");
 
     m_fileIDs[writable] = res->second;
 }
 
 void
 HDF5IOHandlerImpl::readDataset(Writable* writable,
-                               std::map< std::string, ParameterArgument > & parameters)
+                               Parameter< Operation::READ_DATASET > & parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
     hid_t dataset_id, memspace, filespace;
     herr_t status;
-    dataset_id = H5Dopen(res->second,
-                         concrete_h5_file_position(writable).c_str(),
-                         H5P_DEFAULT);
+    dataset_id = openObject(res->second, writable);
     ASSERT(dataset_id >= 0, "Internal error: Failed to open HDF5 dataset during dataset read");
 
+    if( readChunksDirectly(dataset_id, parameters) )
+        return;
+
     std::vector< hsize_t > start;
-    for( auto const& val : parameters.at("offset").get< Offset >() )
+    for( auto const& val : parameters.offset )
         start.push_back(static_cast<hsize_t>(val));
     std::vector< hsize_t > stride(start.size(), 1); /* contiguous region */
     std::vector< hsize_t > count(start.size(), 1); /* single region */
     std::vector< hsize_t > block;
-    for( auto const& val : parameters.at("extent").get< Extent >() )
+    for( auto const& val : parameters.extent )
         block.push_back(static_cast< hsize_t >(val));
-    memspace = H5Screate_simple(block.size(), block.data(), nullptr);
+    memspace = getH5MemorySpace(parameters.extent, parameters.layout);
     filespace = H5Dget_space(dataset_id);
     status = H5Sselect_hyperslab(filespace,
                                  H5S_SELECT_SET,
@@ -984,10 +1476,10 @@ HDF5IOHandlerImpl::readDataset(Writable* writable,
                                  block.data());
     ASSERT(status == 0, "Internal error: Failed to select hyperslab during dataset read");
 
-    void* data = parameters.at("data").get< void* >();
+    void* data = parameters.data;
 
     Attribute a(0);
-    a.dtype = parameters.at("dtype").get< Datatype >();
+    a.dtype = parameters.dtype;
     switch( a.dtype )
     {
         using DT = Datatype;
@@ -1016,30 +1508,190 @@ HDF5IOHandlerImpl::readDataset(Writable* writable,
                      filespace,
                      m_datasetTransferProperty,
                      data);
+    ASSERT(status == 0, "Internal error: Failed to read dataset " + concrete_h5_file_position(writable));
+    status = H5Sclose(memspace);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 memory dataspace during dataset read");
+    status = H5Sclose(filespace);
+    ASSERT(status == 0, "Internal error: Failed to close HDF5 file dataspace during dataset read");
+}
 
-    status = H5Dclose(dataset_id);
+bool
+HDF5IOHandlerImpl::writeChunksDirectly(hid_t dataset_id,
+                                       Parameter< Operation::WRITE_DATASET > const& parameters)
+{
+#if H5_VERSION_GE(1, 10, 3)
+    if( m_chunkWorkers.size() == 0 || !parameters.layout.dense() || parameters.dtype == Datatype::BOOL )
+        return false;
+
+    Attribute a(0);
+    a.dtype = parameters.dtype;
+    H5DirectChunkPlan plan;
+    if( !planDirectChunks(dataset_id, getH5DataType(a), parameters.offset, parameters.extent, plan) )
+        return false;
+
+    char const* data = static_cast< char const* >(parameters.data.get());
+    Offset const zero(plan.chunk.size(), 0);
+    size_t const numChunks = plan.origins.size();
+    size_t const batchSize = 4 * m_chunkWorkers.size();
+    using Batch = std::vector< std::vector< unsigned char > >;
+    auto encodeBatch = [&](size_t begin, Batch& batch)
+    {
+        batch.assign(std::min(batchSize, numChunks - begin), std::vector< unsigned char >());
+        return m_chunkWorkers.forEach(batch.size(),
+                                      [&, begin](size_t i)
+                                      {
+                                          Offset const& origin = plan.origins[begin + i];
+                                          Offset source(origin.size());
+                                          for( size_t k = 0; k < origin.size(); ++k )
+                                              source[k] = origin[k] - parameters.offset[k];
+                                          /* chunks at the boundary of the dataset are padded to full size */
+                                          batch[i].resize(plan.chunkBytes());
+                                          copyBox(batch[i].data(), plan.chunk, zero,
+                                                  data, parameters.extent, source,
+                                                  plan.inside(origin), plan.elementSize);
+                                          encodeChunk(plan.filters, batch[i]);
+                                      });
+    };
+
+    /* filter the next batch of chunks while the current one is written */
+    Batch batches[2];
+    std::future< void > encoded = encodeBatch(0, batches[0]);
+    try
+    {
+        for( size_t begin = 0, b = 0; begin < numChunks; begin += batchSize, b ^= 1 )
+        {
+            encoded.get();
+            Batch const& current = batches[b];
+            if( begin + batchSize < numChunks )
+                encoded = encodeBatch(begin + batchSize, batches[b ^ 1]);
+            for( size_t i = 0; i < current.size(); ++i )
+            {
+                std::vector< hsize_t > origin(plan.origins[begin + i].begin(), plan.origins[begin + i].end());
+                herr_t status = H5Dwrite_chunk(dataset_id,
+                                               m_datasetTransferProperty,
+                                               0,
+                                               origin.data(),
+                                               current[i].size(),
+                                               current[i].data());
+                ASSERT(status == 0, "Internal error: Failed to write HDF5 chunk during dataset write");
+            }
+        }
+    } catch( ... )
+    {
+        /* the workers reference the batches */
+        if( encoded.valid() )
+            encoded.wait();
+        throw;
+    }
+    return true;
+#else
+    (void)dataset_id;
+    (void)parameters;
+    return false;
+#endif
 }
 
-void
-HDF5IOHandlerImpl::readAttribute(Writable* writable,
-                                 std::map< std::string, ParameterArgument >& parameters)
+bool
+HDF5IOHandlerImpl::readChunksDirectly(hid_t dataset_id,
+                                      Parameter< Operation::READ_DATASET > & parameters)
 {
-    auto res = m_fileIDs.find(writable);
-    if( res == m_fileIDs.end() )
-        res = m_fileIDs.find(writable->parent);
+#if H5_VERSION_GE(1, 10, 3)
+    if( m_chunkWorkers.size() == 0 || !parameters.layout.dense() || parameters.dtype == Datatype::BOOL )
+        return false;
 
-    hid_t obj_id, attr_id;
-    herr_t status;
-    obj_id = H5Oopen(res->second,
-                     concrete_h5_file_position(writable).c_str(),
-                     H5P_DEFAULT);
-    ASSERT(obj_id >= 0, "Internal error: Failed to open HDF5 object during attribute read");
-    std::string const & attr_name = parameters.at("name").get< std::string >();
-    attr_id = H5Aopen(obj_id,
-                      attr_name.c_str(),
-                      H5P_DEFAULT);
-    ASSERT(attr_id >= 0, "Internal error: Failed to open HDF5 attribute during attribute read");
+    Attribute a(0);
+    a.dtype = parameters.dtype;
+    H5DirectChunkPlan plan;
+    if( !planDirectChunks(dataset_id, getH5DataType(a), parameters.offset, parameters.extent, plan) )
+        return false;
+
+    /* unallocated chunks have to be filled by HDF5 */
+    size_t const numChunks = plan.origins.size();
+    std::vector< hsize_t > storageSizes(numChunks, 0);
+    for( size_t i = 0; i < numChunks; ++i )
+    {
+        std::vector< hsize_t > origin(plan.origins[i].begin(), plan.origins[i].end());
+        herr_t status = -1;
+        H5E_BEGIN_TRY
+        {
+            status = H5Dget_chunk_storage_size(dataset_id, origin.data(), &storageSizes[i]);
+        } H5E_END_TRY;
+        if( status < 0 || storageSizes[i] == 0 )
+            return false;
+    }
 
+    char* data = static_cast< char* >(parameters.data);
+    Offset const zero(plan.chunk.size(), 0);
+    size_t const batchSize = 4 * m_chunkWorkers.size();
+    struct Stored
+    {
+        std::vector< unsigned char > bytes;
+        uint32_t filterMask;
+    };
+    using Batch = std::vector< Stored >;
+    auto decodeBatch = [&](size_t begin, Batch& batch)
+    {
+        return m_chunkWorkers.forEach(batch.size(),
+                                      [&, begin](size_t i)
+                                      {
+                                          Offset const& origin = plan.origins[begin + i];
+                                          Offset destination(origin.size());
+                                          for( size_t k = 0; k < origin.size(); ++k )
+                                              destination[k] = origin[k] - parameters.offset[k];
+                                          decodeChunk(plan.filters, batch[i].filterMask, batch[i].bytes, plan.chunkBytes());
+                                          if( batch[i].bytes.size() != plan.chunkBytes() )
+                                              throw std::runtime_error("Unexpected size of unfiltered HDF5 chunk");
+                                          copyBox(data, parameters.extent, destination,
+                                                  batch[i].bytes.data(), plan.chunk, zero,
+                                                  plan.inside(origin), plan.elementSize);
+                                      });
+    };
+
+    /* revert the filters of the previous batch of chunks while the current one is read */
+    Batch batches[2];
+    std::future< void > decoded;
+    try
+    {
+        for( size_t begin = 0, b = 0; begin < numChunks; begin += batchSize, b ^= 1 )
+        {
+            Batch& batch = batches[b];
+            batch.assign(std::min(batchSize, numChunks - begin), Stored());
+            for( size_t i = 0; i < batch.size(); ++i )
+            {
+                std::vector< hsize_t > origin(plan.origins[begin + i].begin(), plan.origins[begin + i].end());
+                batch[i].bytes.resize(storageSizes[begin + i]);
+                herr_t status = H5Dread_chunk(dataset_id,
+                                              m_datasetTransferProperty,
+                                              origin.data(),
+                                              &batch[i].filterMask,
+                                              batch[i].bytes.data());
+                ASSERT(status == 0, "Internal error: Failed to read HDF5 chunk during dataset read");
+            }
+            if( decoded.valid() )
+                decoded.get();
+            decoded = decodeBatch(begin, batch);
+        }
+        if( decoded.valid() )
+            decoded.get();
+    } catch( ... )
+    {
+        /* the workers reference the batches */
+        if( decoded.valid() )
+            decoded.wait();
+        throw;
+    }
+    return true;
+#else
+    (void)dataset_id;
+    (void)parameters;
+    return false;
+#endif
+}
+
+Attribute
+HDF5IOHandlerImpl::readAttributeValue(hid_t attr_id, std::string const& attr_name)
+{
+    herr_t status;
     hid_t attr_type, attr_space;
     attr_type = H5Aget_type(attr_id);
     attr_space = H5Aget_space(attr_id);
@@ -1283,36 +1935,111 @@ HDF5IOHandlerImpl::readAttribute(Writable* writable,
             throw std::runtime_error("Unsupported simple attribute type");
     } else
         throw std::runtime_error("Unsupported attribute class");
-    ASSERT(status == 0, "Internal error: Failed to read attribute " + attr_name + " at " + concrete_h5_file_position(writable));
+    ASSERT(status == 0, "Internal error: Failed to read attribute " + attr_name);
+
+    status = H5Sclose(attr_space);
+    ASSERT(status == 0, "Internal error: Failed to close dataspace of attribute " + attr_name);
+    status = H5Tclose(attr_type);
+    ASSERT(status == 0, "Internal error: Failed to close datatype of attribute " + attr_name);
+
+    return a;
+}
+
+void
+HDF5IOHandlerImpl::readAttribute(Writable* writable,
+                                 Parameter< Operation::READ_ATT > & parameters)
+{
+    auto res = m_fileIDs.find(writable);
+    if( res == m_fileIDs.end() )
+        res = m_fileIDs.find(writable->parent);
+
+    hid_t obj_id, attr_id;
+    herr_t status;
+    obj_id = openObject(res->second, writable);
+    ASSERT(obj_id >= 0, "Internal error: Failed to open HDF5 object during attribute read");
+    std::string const& attr_name = parameters.name;
+    attr_id = H5Aopen(obj_id,
+                      attr_name.c_str(),
+                      H5P_DEFAULT);
+    ASSERT(attr_id >= 0, "Internal error: Failed to open HDF5 attribute during attribute read");
+
+    Attribute a = readAttributeValue(attr_id, attr_name);
 
-    auto dtype = parameters.at("dtype").get< std::shared_ptr< Datatype > >();
-    *dtype = a.dtype;
-    auto resource = parameters.at("resource").get< std::shared_ptr< Attribute::resource > >();
-    *resource = a.getResource();
+    *parameters.dtype = a.dtype;
+    *parameters.resource = a.getResource();
 
     status = H5Aclose(attr_id);
     ASSERT(status == 0, "Internal error: Failed to close attribute " + attr_name + " at " + concrete_h5_file_position(writable) + " during attribute read");
-    status = H5Oclose(obj_id);
-    ASSERT(status == 0, "Internal error: Failed to close " + concrete_h5_file_position(writable) + " during attribute read");
+}
+
+void
+HDF5IOHandlerImpl::readAllAttributes(Writable* writable,
+                                     Parameter< Operation::READ_ALL_ATTS > & parameters)
+{
+    auto res = m_fileIDs.find(writable);
+    if( res == m_fileIDs.end() )
+        res = m_fileIDs.find(writable->parent);
+
+    hid_t obj_id = openObject(res->second, writable);
+    ASSERT(obj_id >= 0, "Internal error: Failed to open HDF5 object during attribute read");
+
+    /* exceptions must not propagate through the HDF5 library */
+    struct Visitor
+    {
+        HDF5IOHandlerImpl* impl;
+        std::map< std::string, Attribute >* attributes;
+        std::exception_ptr error;
+    } visitor{this, parameters.attributes.get(), nullptr};
+
+    auto visit = [](hid_t location_id, char const* attr_name, H5A_info_t const*, void* op_data) -> herr_t
+    {
+        Visitor* v = static_cast< Visitor* >(op_data);
+        hid_t attr_id = H5Aopen(location_id, attr_name, H5P_DEFAULT);
+        if( attr_id < 0 )
+            return -1;
+
+        herr_t ret = 0;
+        try
+        {
+            v->attributes->emplace(attr_name, v->impl->readAttributeValue(attr_id, attr_name));
+        } catch( unsupported_data_error const& e )
+        {
+            std::cerr << "Skipping non-standard attribute "
+                      << attr_name << " ("
+                      << e.what()
+                      << ")\n";
+        } catch( ... )
+        {
+            v->error = std::current_exception();
+            ret = -1;
+        }
+        if( H5Aclose(attr_id) != 0 )
+            ret = -1;
+        return ret;
+    };
+
+    hsize_t idx = 0;
+    herr_t status = H5Aiterate2(obj_id, H5_INDEX_NAME, H5_ITER_NATIVE, &idx, visit, &visitor);
+    if( visitor.error )
+        std::rethrow_exception(visitor.error);
+    ASSERT(status == 0, "Internal error: Failed to iterate over attributes at " + concrete_h5_file_position(writable));
 }
 
 void
 HDF5IOHandlerImpl::listPaths(Writable* writable,
-                             std::map< std::string, ParameterArgument > & parameters)
+                             Parameter< Operation::LIST_PATHS > & parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
-    hid_t node_id = H5Gopen(res->second,
-                            concrete_h5_file_position(writable).c_str(),
-                            H5P_DEFAULT);
+    hid_t node_id = openObject(res->second, writable);
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during path listing");
 
     H5G_info_t group_info;
     herr_t status = H5Gget_info(node_id, &group_info);
     ASSERT(status == 0, "Internal error: Failed to get HDF5 group info for " + concrete_h5_file_position(writable) + " during path listing");
 
-    auto paths = parameters.at("paths").get< std::shared_ptr< std::vector< std::string > > >();
+    auto& paths = parameters.paths;
     for( hsize_t i = 0; i < group_info.nlinks; ++i )
     {
         if( H5G_GROUP == H5Gget_objtype_by_idx(node_id, i) )
@@ -1324,27 +2051,23 @@ HDF5IOHandlerImpl::listPaths(Writable* writable,
         }
     }
 
-    status = H5Gclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close HDF5 group " + concrete_h5_file_position(writable) + " during path listing");
 }
 
 void
 HDF5IOHandlerImpl::listDatasets(Writable* writable,
-                                std::map< std::string, ParameterArgument >& parameters)
+                                Parameter< Operation::LIST_DATASETS > & parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
-    hid_t node_id = H5Gopen(res->second,
-                            concrete_h5_file_position(writable).c_str(),
-                            H5P_DEFAULT);
+    hid_t node_id = openObject(res->second, writable);
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during dataset listing");
 
     H5G_info_t group_info;
     herr_t status = H5Gget_info(node_id, &group_info);
     ASSERT(status == 0, "Internal error: Failed to get HDF5 group info for " + concrete_h5_file_position(writable) + " during dataset listing");
 
-    auto datasets = parameters.at("datasets").get< std::shared_ptr< std::vector< std::string > > >();
+    auto& datasets = parameters.datasets;
     for( hsize_t i = 0; i < group_info.nlinks; ++i )
     {
         if( H5G_DATASET == H5Gget_objtype_by_idx(node_id, i) )
@@ -1356,20 +2079,16 @@ HDF5IOHandlerImpl::listDatasets(Writable* writable,
         }
     }
 
-    status = H5Gclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close HDF5 group " + concrete_h5_file_position(writable) + " during dataset listing");
 }
 
 void HDF5IOHandlerImpl::listAttributes(Writable* writable,
-                                       std::map< std::string, ParameterArgument >& parameters)
+                                       Parameter< Operation::LIST_ATTS > & parameters)
 {
     auto res = m_fileIDs.find(writable);
     if( res == m_fileIDs.end() )
         res = m_fileIDs.find(writable->parent);
     hid_t node_id;
-    node_id = H5Oopen(res->second,
-                      concrete_h5_file_position(writable).c_str(),
-                      H5P_DEFAULT);
+    node_id = openObject(res->second, writable);
     ASSERT(node_id >= 0, "Internal error: Failed to open HDF5 group during attribute listing");
 
     H5O_info_t object_info;
@@ -1377,7 +2096,7 @@ void HDF5IOHandlerImpl::listAttributes(Writable* writable,
     status = H5Oget_info(node_id, &object_info);
     ASSERT(status == 0, "Internal error: Failed to get HDF5 object info for " + concrete_h5_file_position(writable) + " during attribute listing");
 
-    auto strings = parameters.at("attributes").get< std::shared_ptr< std::vector< std::string > > >();
+    auto& strings = parameters.attributes;
     for( hsize_t i = 0; i < object_info.num_attrs; ++i )
     {
         ssize_t name_length = H5Aget_name_by_idx(node_id,
@@ -1399,9 +2118,6 @@ void HDF5IOHandlerImpl::listAttributes(Writable* writable,
                            H5P_DEFAULT);
         strings->push_back(std::string(name.data(), name_length));
     }
-
-    status = H5Oclose(node_id);
-    ASSERT(status == 0, "Internal error: Failed to close HDF5 object during attribute listing");
 }
 #else
 HDF5IOHandler::HDF5IOHandler(std::string const& path, AccessType at)
@@ -1418,4 +2134,16 @@ HDF5IOHandler::flush()
 {
     return std::future< void >();
 }
+
+void
+HDF5IOHandler::setMaxOpenFiles(size_t)
+{ }
+
+void
+HDF5IOHandler::setCompressionThreads(unsigned int)
+{ }
+
+void
+HDF5IOHandler::setFileTuning(FileTuning const&)
+{ }
 #endif
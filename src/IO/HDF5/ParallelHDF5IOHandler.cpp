@@ -30,6 +30,12 @@ ParallelHDF5IOHandler::flush()
     return m_impl->flush();
 }
 
+void
+ParallelHDF5IOHandler::setFileTuning(FileTuning const& tuning)
+{
+    m_impl->m_fileTuning = tuning;
+}
+
 ParallelHDF5IOHandlerImpl::ParallelHDF5IOHandlerImpl(AbstractIOHandler* handler)
         : HDF5IOHandlerImpl{handler},
           m_mpiComm{MPI_COMM_WORLD},
@@ -81,4 +87,8 @@ ParallelHDF5IOHandler::flush()
 {
     return std::future< void >();
 }
+
+void
+ParallelHDF5IOHandler::setFileTuning(FileTuning const&)
+{ }
 #endif
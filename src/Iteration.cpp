@@ -26,7 +26,9 @@
 
 Iteration::Iteration()
         : meshes{Container< Mesh >()},
-          particles{Container< ParticleSpecies >()}
+          particles{Container< ParticleSpecies >()},
+          m_closed{false},
+          m_deferred{false}
 {
     setTime(static_cast< double >(0));
     setDt(static_cast< double >(1));
@@ -36,7 +38,11 @@ Iteration::Iteration()
 Iteration::Iteration(Iteration const& i)
         : Attributable{i},
           meshes{i.meshes},
-          particles{i.particles}
+          particles{i.particles},
+          m_closed{i.m_closed},
+          m_deferred{i.m_deferred},
+          m_deferredFile{i.m_deferredFile},
+          m_deferredPath{i.m_deferredPath}
 {
     IOHandler = i.IOHandler;
     parent = i.parent;
@@ -79,6 +85,29 @@ Iteration::setTimeUnitSI(double timeUnitSI)
     return *this;
 }
 
+Iteration&
+Iteration::close()
+{
+    Writable *w = this;
+    while( w->parent )
+        w = w->parent;
+    Series* o = dynamic_cast<Series *>(w);
+
+    /* pending changes of all iterations are written */
+    o->flush().get();
+
+    /* iterations that have not been read yet do not hold a file */
+    if( o->iterationEncoding() == IterationEncoding::fileBased && written && !m_deferred )
+    {
+        Parameter< Operation::CLOSE_FILE > fClose;
+        IOHandler->enqueue(IOTask(this, fClose));
+        IOHandler->flush();
+        m_closed = true;
+    }
+
+    return *this;
+}
+
 void
 Iteration::flushFileBased(uint64_t i)
 {
@@ -89,18 +118,15 @@ Iteration::flushFileBased(uint64_t i)
         Parameter< Operation::CREATE_FILE > fCreate;
         fCreate.name = replace_first(o->iterationFormat(), "%T", std::to_string(i));
         IOHandler->enqueue(IOTask(o, fCreate));
-        IOHandler->flush();
 
         /* create basePath */
         Parameter< Operation::CREATE_PATH > pCreate;
         pCreate.path = replace_first(o->basePath(), "%T/", "");
         IOHandler->enqueue(IOTask(&o->iterations, pCreate));
-        IOHandler->flush();
 
         /* create iteration path */
         pCreate.path = std::to_string(i);
         IOHandler->enqueue(IOTask(this, pCreate));
-        IOHandler->flush();
     } else
     {
         /* open file */
@@ -108,18 +134,15 @@ Iteration::flushFileBased(uint64_t i)
         Parameter< Operation::OPEN_FILE > fOpen;
         fOpen.name = replace_last(o->iterationFormat(), "%T", std::to_string(i));
         IOHandler->enqueue(IOTask(o, fOpen));
-        IOHandler->flush();
 
         /* open basePath */
         Parameter< Operation::OPEN_PATH > pOpen;
         pOpen.path = replace_first(o->basePath(), "%T/", "");
         IOHandler->enqueue(IOTask(&o->iterations, pOpen));
-        IOHandler->flush();
 
         /* open iteration path */
         pOpen.path = std::to_string(i);
         IOHandler->enqueue(IOTask(this, pOpen));
-        IOHandler->flush();
     }
 
     flush();
@@ -134,7 +157,6 @@ Iteration::flushGroupBased(uint64_t i)
         Parameter< Operation::CREATE_PATH > pCreate;
         pCreate.path = std::to_string(i);
         IOHandler->enqueue(IOTask(this, pCreate));
-        IOHandler->flush();
     }
 
     flush();
@@ -150,15 +172,25 @@ Iteration::flush()
         w = w->parent;
     Series* o = dynamic_cast<Series *>(w);
 
-    meshes.flush(o->meshesPath());
-    for( auto& m : meshes )
-        m.second.flush(m.first);
+    /* unmodified branches have already been flushed completely */
+    if( meshes.dirtyRecursive )
+    {
+        meshes.flush(o->meshesPath());
+        for( auto& m : meshes )
+            m.second.flush(m.first);
+        meshes.dirtyRecursive = false;
+    }
 
-    particles.flush(o->particlesPath());
-    for( auto& species : particles )
-        species.second.flush(species.first);
+    if( particles.dirtyRecursive )
+    {
+        particles.flush(o->particlesPath());
+        for( auto& species : particles )
+            species.second.flush(species.first);
+        particles.dirtyRecursive = false;
+    }
 
     flushAttributes();
+    dirtyRecursive = false;
 }
 
 void
@@ -258,7 +290,7 @@ Iteration::read()
         mrc.abstractFilePosition = m.abstractFilePosition;
         mrc.parent = m.parent;
         mrc.written = false;
-        mrc.resetDataset(Dataset(*dOpen.dtype, *dOpen.extent));
+        mrc.resetDataset(dOpen.dataset());
         mrc.written = true;
         m.read();
     }
@@ -290,6 +322,74 @@ Iteration::read()
     meshes.written = true;
     particles.written = true;
     written = true;
+    meshes.dirtyRecursive = false;
+    particles.dirtyRecursive = false;
+    dirtyRecursive = false;
+}
+
+void
+Iteration::deferRead(std::string const& file, std::string const& path)
+{
+    m_deferred = true;
+    m_deferredFile = file;
+    m_deferredPath = path;
+
+    /* the iteration exists on disk, its default attributes must not be flushed */
+    meshes.written = true;
+    particles.written = true;
+    written = true;
+    dirty = false;
+    dirtyRecursive = false;
+}
+
+void
+Iteration::readDeferred()
+{
+    if( !m_deferred )
+        return;
+
+    Writable *w = this;
+    while( w->parent )
+        w = w->parent;
+    Series* o = dynamic_cast<Series *>(w);
+
+    if( !m_deferredFile.empty() )
+    {
+        /* fileBased: the iterations group has to be re-opened in the file of this iteration */
+        Parameter< Operation::OPEN_FILE > fOpen;
+        fOpen.name = m_deferredFile;
+        IOHandler->enqueue(IOTask(o, fOpen));
+
+        Parameter< Operation::OPEN_PATH > pOpen;
+        pOpen.path = replace_first(o->basePath(), "/%T/", "");
+        IOHandler->enqueue(IOTask(&o->iterations, pOpen));
+    }
+
+    Parameter< Operation::OPEN_PATH > pOpen;
+    pOpen.path = m_deferredPath;
+    IOHandler->enqueue(IOTask(this, pOpen));
+    IOHandler->flush();
+
+    m_deferred = false;
+    m_deferredFile.clear();
+    m_deferredPath.clear();
+
+    meshes.written = false;
+    particles.written = false;
+    read();
+}
+
+void
+onAccess(Iteration& i)
+{
+    i.m_closed = false;
+    i.readDeferred();
+}
+
+void
+onLoad(Iteration& i)
+{
+    i.readDeferred();
 }
 
 
@@ -170,6 +170,9 @@ Mesh::setTimeOffset(T to)
 void
 Mesh::flush(std::string const& name)
 {
+    if( written && !isDirtyRecursive() )
+        return;
+
     if( !written )
     {
         if( m_containsScalar )
@@ -177,6 +180,8 @@ Mesh::flush(std::string const& name)
             MeshRecordComponent& r = at(RecordComponent::SCALAR);
             r.parent = parent;
             r.flush(name);
+            /* the position of the component is only known after creation */
+            IOHandler->flush();
             abstractFilePosition = r.abstractFilePosition;
             written = true;
         } else
@@ -184,7 +189,6 @@ Mesh::flush(std::string const& name)
             Parameter< Operation::CREATE_PATH > pCreate;
             pCreate.path = name;
             IOHandler->enqueue(IOTask(this, pCreate));
-            IOHandler->flush();
             for( auto& comp : *this )
                 comp.second.parent = this;
         }
@@ -194,6 +198,7 @@ Mesh::flush(std::string const& name)
         comp.second.flush(comp.first);
 
     flushAttributes();
+    dirtyRecursive = false;
 }
 
 void
@@ -310,7 +315,7 @@ Mesh::read()
             IOHandler->enqueue(IOTask(&rc, dOpen));
             IOHandler->flush();
             rc.written = false;
-            rc.resetDataset(Dataset(*dOpen.dtype, *dOpen.extent));
+            rc.resetDataset(dOpen.dataset());
             rc.written = true;
             rc.read();
         }
@@ -322,6 +327,7 @@ Mesh::read()
 
     /* this file need not be flushed */
     written = true;
+    dirtyRecursive = false;
 }
 
 std::ostream&
@@ -68,6 +68,8 @@ ParticlePatches::read()
         dRead.data = data.get();
         IOHandler->enqueue(IOTask(&pr, dRead));
         IOHandler->flush();
+        prc.dirtyRecursive = false;
+        pr.dirtyRecursive = false;
 
         uint64_t *raw_ptr = static_cast< uint64_t* >(data.get());
         if( "numParticles" == component_name )
@@ -89,4 +91,6 @@ ParticlePatches::read()
     m_patchPositions.reserve(numParticles.size());
     for( size_t i = 0; i < numParticles.size(); ++i )
         m_patchPositions.emplace_back(PatchPosition(numParticles[i], numParticlesOffset[i]));
+
+    dirtyRecursive = false;
 }
\ No newline at end of file
@@ -67,7 +67,7 @@ ParticleSpecies::read()
         rc.abstractFilePosition = r.abstractFilePosition;
         rc.parent = r.parent;
         rc.written = false;
-        rc.resetDataset(Dataset(*dOpen.dtype, *dOpen.extent));
+        rc.resetDataset(dOpen.dataset());
         rc.written = true;
         r.read();
     }
@@ -76,19 +76,30 @@ ParticleSpecies::read()
 
     /* this file need not be flushed */
     written = true;
+    particlePatches.dirtyRecursive = false;
+    dirtyRecursive = false;
 }
 
 void
 ParticleSpecies::flush(std::string const& path)
 {
+    if( written && !dirtyRecursive )
+        return;
+
     Container< Record >::flush(path);
 
     for( auto& record : *this )
         record.second.flush(record.first);
 
-    particlePatches.flush("particlePatches");
-    for( auto& patch : particlePatches )
-        patch.second.flush(patch.first);
+    if( particlePatches.dirtyRecursive )
+    {
+        particlePatches.flush("particlePatches");
+        for( auto& patch : particlePatches )
+            patch.second.flush(patch.first);
+        particlePatches.dirtyRecursive = false;
+    }
+
+    dirtyRecursive = false;
 }
 
 template<>
@@ -27,6 +27,9 @@ Record::setUnitDimension(std::map< UnitDimension, double > const& udim)
 void
 Record::flush(std::string const& name)
 {
+    if( written && !isDirtyRecursive() )
+        return;
+
     if( !written )
     {
         if( m_containsScalar )
@@ -34,6 +37,8 @@ Record::flush(std::string const& name)
             RecordComponent& r = at(RecordComponent::SCALAR);
             r.parent = parent;
             r.flush(name);
+            /* the position of the component is only known after creation */
+            IOHandler->flush();
             abstractFilePosition = r.abstractFilePosition;
             written = true;
         } else
@@ -41,7 +46,6 @@ Record::flush(std::string const& name)
             Parameter< Operation::CREATE_PATH > pCreate;
             pCreate.path = name;
             IOHandler->enqueue(IOTask(this, pCreate));
-            IOHandler->flush();
             for( auto& comp : *this )
                 comp.second.parent = this;
         }
@@ -51,6 +55,7 @@ Record::flush(std::string const& name)
         comp.second.flush(comp.first);
 
     flushAttributes();
+    dirtyRecursive = false;
 }
 
 void
@@ -93,7 +98,7 @@ Record::read()
             IOHandler->enqueue(IOTask(&rc, dOpen));
             IOHandler->flush();
             rc.written = false;
-            rc.resetDataset(Dataset(*dOpen.dtype, *dOpen.extent));
+            rc.resetDataset(dOpen.dataset());
             rc.written = true;
             rc.read();
         }
@@ -105,4 +110,5 @@ Record::read()
 
     /* this file need not be flushed */
     written = true;
+    dirtyRecursive = false;
 }
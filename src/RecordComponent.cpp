@@ -1,13 +1,62 @@
+#include <algorithm>
 #include <iostream>
 #include "../include/RecordComponent.hpp"
+#include "Series.hpp"
 
 
 RecordComponent::RecordComponent()
-        : m_constantValue{-1}
+        : m_pendingBytes{0},
+          m_constantValue{-1}
 {
     setUnitSI(1);
 }
 
+RecordComponent::RecordComponent(RecordComponent const& other)
+        : BaseRecordComponent(other),
+          m_chunks{other.m_chunks},
+          m_pendingBytes{other.m_pendingBytes},
+          m_constantValue{other.m_constantValue}
+{
+    if( IOHandler && m_pendingBytes > 0 )
+    {
+        IOHandler->pendingBytes += m_pendingBytes;
+        IOHandler->pendingComponents.insert(this);
+    }
+}
+
+RecordComponent&
+RecordComponent::operator=(RecordComponent const& other)
+{
+    if( this == &other )
+        return *this;
+
+    if( IOHandler )
+    {
+        IOHandler->pendingBytes -= m_pendingBytes;
+        IOHandler->pendingComponents.erase(this);
+    }
+    BaseRecordComponent::operator=(other);
+    m_chunks = other.m_chunks;
+    m_pendingBytes = other.m_pendingBytes;
+    m_constantValue = other.m_constantValue;
+    if( IOHandler && m_pendingBytes > 0 )
+    {
+        IOHandler->pendingBytes += m_pendingBytes;
+        IOHandler->pendingComponents.insert(this);
+    }
+    return *this;
+}
+
+RecordComponent::~RecordComponent()
+{
+    /* chunks of erased or destroyed components are never flushed */
+    if( IOHandler )
+    {
+        IOHandler->pendingBytes -= m_pendingBytes;
+        IOHandler->pendingComponents.erase(this);
+    }
+}
+
 RecordComponent&
 RecordComponent::setUnitSI(double usi)
 {
@@ -20,9 +69,12 @@ RecordComponent::resetDataset(Dataset d)
 {
     if( written )
         throw std::runtime_error("A Records Dataset can not (yet) be changed after it has been written.");
+    /* reject contradicting settings before anything is enqueued */
+    d.resolvedLayout();
 
     m_dataset = d;
     dirty = true;
+    setDirtyRecursive();
     return *this;
 }
 
@@ -38,9 +90,30 @@ RecordComponent::getExtent()
     return m_dataset.extent;
 }
 
+Dataset::Layout
+RecordComponent::getLayout()
+{
+    return m_dataset.layout;
+}
+
+Extent
+RecordComponent::getChunkSize()
+{
+    return m_dataset.chunkSize;
+}
+
+std::vector< Dataset::Filter >
+RecordComponent::getFilters()
+{
+    return m_dataset.filters;
+}
+
 void
 RecordComponent::flush(std::string const& name)
 {
+    if( written && !dirtyRecursive )
+        return;
+
     if( !written )
     {
         if( m_isConstant )
@@ -64,22 +137,110 @@ RecordComponent::flush(std::string const& name)
             dCreate.name = name;
             dCreate.extent = getExtent();
             dCreate.dtype = getDatatype();
+            /* settle layout and chunk shape now so they can be reported until the dataset is read again */
+            m_dataset.layout = m_dataset.resolvedLayout();
+            if( m_dataset.layout == Dataset::Layout::CHUNKED && m_dataset.chunkSize.empty() )
+                m_dataset.chunkSize = m_dataset.automaticChunkSize();
+            dCreate.layout = m_dataset.layout;
             dCreate.chunkSize = m_dataset.chunkSize;
             dCreate.compression = m_dataset.compression;
             dCreate.transform = m_dataset.transform;
+            dCreate.filters = m_dataset.filters;
+            dCreate.fillTime = m_dataset.fillTime;
+            dCreate.allocationTime = m_dataset.allocationTime;
             IOHandler->enqueue(IOTask(this, dCreate));
         }
-        IOHandler->flush();
     }
 
+    flushChunks();
+
+    flushAttributes();
+    dirtyRecursive = false;
+}
+
+void
+RecordComponent::checkMemoryLayout(Extent const& e, MemoryLayout const& layout) const
+{
+    if( layout.dense() )
+        return;
+
+    if( layout.shape.size() != e.size() )
+        throw std::runtime_error("Dimensionality of chunk and memory layout do not match.");
+    for( size_t i = 0; i < e.size(); ++i )
+        if( e[i] > 0 && layout.shape[i] <= layout.offset[i] + (e[i] - 1) * layout.stride[i] )
+            throw std::runtime_error("Chunk does not reside inside memory buffer (Dimension on index " + std::to_string(i)
+                                     + " - Buffer: " + std::to_string(layout.shape[i])
+                                     + " - Chunk: " + std::to_string(layout.offset[i] + (e[i] - 1) * layout.stride[i] + 1)
+                                     + ")");
+}
+
+void
+RecordComponent::flushChunks()
+{
     while( !m_chunks.empty() )
     {
         IOHandler->enqueue(m_chunks.front());
         m_chunks.pop();
-        IOHandler->flush();
     }
+    IOHandler->pendingBytes -= m_pendingBytes;
+    m_pendingBytes = 0;
+    IOHandler->pendingComponents.erase(this);
+}
 
-    flushAttributes();
+void
+RecordComponent::limitPendingBytes()
+{
+    if( IOHandler->maxPendingBytes == 0 || IOHandler->pendingBytes <= IOHandler->maxPendingBytes )
+        return;
+
+    std::vector< RecordComponent* > components(IOHandler->pendingComponents.begin(), IOHandler->pendingComponents.end());
+    std::sort(components.begin(), components.end(),
+              [](RecordComponent const* a, RecordComponent const* b){ return a->m_pendingBytes > b->m_pendingBytes; });
+    for( RecordComponent* rc : components )
+    {
+        if( IOHandler->pendingBytes <= IOHandler->maxPendingBytes )
+            break;
+        if( rc->written )
+            rc->flushChunks();
+    }
+
+    if( IOHandler->pendingBytes > IOHandler->maxPendingBytes )
+    {
+        /* the datasets of the remaining chunks are created along with the rest of the series */
+        Writable* w = this;
+        while( w->parent )
+            w = w->parent;
+        Series* o = dynamic_cast< Series* >(w);
+        if( o )
+        {
+            o->flush().get();
+            return;
+        }
+    }
+    IOHandler->flushAsynchronously().get();
+}
+
+std::shared_ptr< void >
+RecordComponent::stagingBuffer(size_t bytes)
+{
+    std::shared_ptr< StagingBufferPool > pool = IOHandler->stagingBuffers;
+    std::shared_ptr< void > staged = pool->acquire(bytes);
+    if( !staged && bytes <= pool->capacity() )
+    {
+        /* buffers of previous chunks are recycled once they have been written */
+        Writable* w = this;
+        while( w->parent )
+            w = w->parent;
+        Series* o = dynamic_cast< Series* >(w);
+        if( o )
+        {
+            o->flush().get();
+            staged = pool->acquire(bytes);
+        }
+    }
+    if( !staged )
+        staged = std::shared_ptr< char >(new char[bytes], [](char* p){ delete[] p; });
+    return staged;
 }
 
 void
@@ -92,6 +253,7 @@ RecordComponent::read()
 
     /* this file need not be flushed */
     written = true;
+    dirtyRecursive = false;
 }
 
 void
@@ -18,8 +18,14 @@
  * and the GNU Lesser General Public License along with libopenPMD.
  * If not, see <http://www.gnu.org/licenses/>.
  */
+#include <algorithm>
+#include <atomic>
+#include <ctime>
+#include <fstream>
 #include <iostream>
+#include <memory>
 #include <regex>
+#include <thread>
 
 #include <boost/filesystem.hpp>
 
@@ -31,16 +37,18 @@ Series Series::create(std::string const& path,
                       std::string const& name,
                       IterationEncoding ie,
                       Format f,
-                      AccessType at)
+                      AccessType at,
+                      bool asynchronous)
 {
-    return Series(path, name, ie, f, at);
+    return Series(path, name, ie, f, at, asynchronous);
 }
 
 Series::Series(std::string const& path,
                std::string const& name,
                IterationEncoding ie,
                Format f,
-               AccessType at)
+               AccessType at,
+               bool asynchronous)
         : iterations{Container< Iteration, uint64_t >()},
           m_name{cleanFilename(name, f)}
 {
@@ -48,7 +56,7 @@ Series::Series(std::string const& path,
     if( !ends_with(cleanPath, "/") )
         cleanPath += '/';
 
-    IOHandler = AbstractIOHandler::createIOHandler(cleanPath, at, f);
+    IOHandler = AbstractIOHandler::createIOHandler(cleanPath, at, f, asynchronous);
     iterations.IOHandler = IOHandler;
     iterations.parent = this;
 
@@ -70,9 +78,9 @@ Series::Series(std::string const& path,
         case AccessType::READ_WRITE:
         {
             if( contains(m_name, "%T") )
-                readFileBased();
+                readFileBased(false, false, false);
             else
-                readGroupBased();
+                readGroupBased(false);
             break;
         }
     }
@@ -83,13 +91,23 @@ Series Series::read(std::string const& path,
                     bool readonly,
                     bool parallel)
 {
-    return Series(path, name, readonly, parallel);
+    return Series(path, name, readonly, parallel, ReadOptions());
+}
+
+Series Series::read(std::string const& path,
+                    std::string const& name,
+                    ReadOptions const& options,
+                    bool readonly,
+                    bool parallel)
+{
+    return Series(path, name, readonly, parallel, options);
 }
 
 Series::Series(std::string path,
                std::string const& name,
                bool readonly,
-               bool parallel)
+               bool parallel,
+               ReadOptions const& options)
     : iterations{Container< Iteration, uint64_t >()}
 {
     if( !ends_with(path, "/") )
@@ -108,9 +126,9 @@ Series::Series(std::string path,
     m_name = cleanFilename(name, f);
 
     if( contains(m_name, "%T") )
-        readFileBased();
+        readFileBased(options.lazy, options.lazy && options.indexed, !options.lazy && options.prefetch);
     else
-        readGroupBased();
+        readGroupBased(options.lazy);
 }
 
 Series::~Series()
@@ -259,6 +277,7 @@ Series::setIterationEncoding(IterationEncoding ie)
     if( written )
         throw std::runtime_error("A files iterationEncoding can not (yet) be changed after it has been written.");
 
+    m_iterationEncoding = ie;
     switch( ie )
     {
         case IterationEncoding::fileBased:
@@ -270,7 +289,6 @@ Series::setIterationEncoding(IterationEncoding ie)
             setAttribute("iterationEncoding", std::string("groupBased"));
             break;
     }
-    m_iterationEncoding = ie;
     dirty = true;
     return *this;
 }
@@ -316,7 +334,56 @@ Series::setName(std::string const& n)
     return *this;
 }
 
-void
+Series&
+Series::setMaxOpenFiles(size_t maxOpenFiles)
+{
+    IOHandler->setMaxOpenFiles(maxOpenFiles);
+    return *this;
+}
+
+Series&
+Series::setCompressionThreads(unsigned int numThreads)
+{
+    IOHandler->setCompressionThreads(numThreads);
+    return *this;
+}
+
+Series&
+Series::setFileTuning(FileTuning const& tuning)
+{
+    if( tuning.alignment == 0 )
+        throw std::runtime_error("File alignment must not be zero");
+    if( tuning.pageSize > 0 && tuning.pageSize < 512 )
+        throw std::runtime_error("File space page size must be at least 512 bytes");
+
+    IOHandler->setFileTuning(tuning);
+    return *this;
+}
+
+Series&
+Series::setCopyOnStore(size_t maxBytes)
+{
+    if( maxBytes == 0 )
+        IOHandler->stagingBuffers.reset();
+    else
+        IOHandler->stagingBuffers = std::make_shared< StagingBufferPool >(maxBytes);
+    return *this;
+}
+
+size_t
+Series::pendingBytes() const
+{
+    return IOHandler->pendingBytes;
+}
+
+Series&
+Series::setMaxPendingBytes(size_t maxPendingBytes)
+{
+    IOHandler->maxPendingBytes = maxPendingBytes;
+    return *this;
+}
+
+std::future< void >
 Series::flush()
 {
     if( IOHandler->accessType == AccessType::READ_WRITE ||
@@ -333,6 +400,9 @@ Series::flush()
                 break;
         }
     }
+
+    /* all pending operations of this Series are submitted as one batch */
+    return IOHandler->flushAsynchronously();
 }
 
 void
@@ -341,23 +411,40 @@ Series::flushFileBased()
     if( iterations.empty() )
         throw std::runtime_error("fileBased output can not be written with no iterations.");
 
-    for( auto& i : iterations )
+    bool const seriesDirty = dirty;
+    for( auto& i : iterations.m_container )
     {
+        /* unmodified iterations are up to date,
+         * their files need not be re-opened unless the Series attributes changed */
+        if( !seriesDirty && !i.second.dirtyRecursive )
+            continue;
+
+        /* every iteration lives in its own file,
+         * operations on the previous file have to complete before the next file is touched */
+        IOHandler->flush();
+
         /* as there is only one series,
          * emulate the file belonging to each iteration as not yet written */
         written = false;
         iterations.written = false;
 
+        bool const newFile = !i.second.written;
         i.second.flushFileBased(i.first);
 
         iterations.flush(replace_first(basePath(), "%T/", ""));
 
-        if( dirty )
+        /* every file holds a copy of the Series attributes */
+        if( seriesDirty || newFile )
         {
-            flushAttributes();
-            /* manually flag the Series dirty
-             * until all iterations have been updated */
             dirty = true;
+            flushAttributes();
+        }
+
+        /* a closed iteration modified through a retained reference is only re-opened for this flush */
+        if( i.second.m_closed )
+        {
+            Parameter< Operation::CLOSE_FILE > fClose;
+            IOHandler->enqueue(IOTask(&i.second, fClose));
         }
     }
     dirty = false;
@@ -371,15 +458,16 @@ Series::flushGroupBased()
         Parameter< Operation::CREATE_FILE > fCreate;
         fCreate.name = m_name;
         IOHandler->enqueue(IOTask(this, fCreate));
-        IOHandler->flush();
     }
 
     if( !iterations.written )
         iterations.parent = this;
     iterations.flush(replace_first(basePath(), "%T/", ""));
 
-    for( auto& i : iterations )
+    for( auto& i : iterations.m_container )
     {
+        if( !i.second.dirtyRecursive )
+            continue;
         if( !i.second.written )
             i.second.parent = &iterations;
         i.second.flushGroupBased(i.first);
@@ -388,21 +476,117 @@ Series::flushGroupBased()
     flushAttributes();
 }
 
+/** Reads the leading block of every file in a fileBased series on worker threads.
+ *
+ * HDF5 must not be called concurrently, hence the metadata is still parsed serially.
+ * The workers run ahead of the parse and open each file, reading the block that holds
+ * its superblock and root group. This overlaps the file open latency of (parallel)
+ * file systems and lets the parse find the metadata in the page cache.
+ */
+class FilePrefetcher
+{
+public:
+    FilePrefetcher(std::string const& directory,
+                   std::vector< std::string > const& files)
+            : m_directory{directory},
+              m_files{files},
+              m_next{0},
+              m_stop{false}
+    {
+        unsigned int numThreads = std::min(MAX_THREADS, std::max(1u, std::thread::hardware_concurrency()));
+        for( unsigned int i = 0; i < numThreads; ++i )
+            m_workers.emplace_back(&FilePrefetcher::run, this);
+    }
+
+    ~FilePrefetcher()
+    {
+        m_stop = true;
+        for( auto& worker : m_workers )
+            worker.join();
+    }
+
+private:
+    void run()
+    {
+        std::vector< char > buffer(PREFETCH_BYTES);
+        for( size_t i = m_next++; i < m_files.size() && !m_stop; i = m_next++ )
+        {
+            std::ifstream in(m_directory + m_files[i], std::ios::binary);
+            in.read(buffer.data(), buffer.size());
+        }
+    }
+
+    static constexpr unsigned int MAX_THREADS = 8;
+    static constexpr size_t PREFETCH_BYTES = 64 * 1024;
+
+    std::string const m_directory;
+    std::vector< std::string > const& m_files;
+    std::atomic< size_t > m_next;
+    std::atomic< bool > m_stop;
+    std::vector< std::thread > m_workers;
+};
+
+constexpr unsigned int FilePrefetcher::MAX_THREADS;
+constexpr size_t FilePrefetcher::PREFETCH_BYTES;
+
 void
-Series::readFileBased()
+Series::readFileBased(bool lazy, bool indexed, bool prefetch)
 {
-    std::regex pattern(replace_first(m_name, "%T", "[[:digit:]]+"));
+    std::regex pattern(replace_first(m_name, "%T", "([[:digit:]]+)"));
+    std::smatch match;
+    bool headerRead = false;
+
+    std::vector< std::string > files;
+    if( !indexed || !readIndex(files) )
+    {
+        using namespace boost::filesystem;
+        path dir(IOHandler->directory);
+
+        /* the index has to exist before the directory is inspected,
+         * creating it modifies the directory while overwriting it does not */
+        bool writeIdx = indexed && IOHandler->accessType != AccessType::READ_ONLY && createIndex();
+        int64_t directoryTime = 0;
+        int64_t scanTime = 0;
+        if( writeIdx )
+        {
+            boost::system::error_code ec;
+            directoryTime = static_cast< int64_t >(last_write_time(dir, ec));
+            scanTime = static_cast< int64_t >(std::time(nullptr));
+            writeIdx = !ec;
+        }
+
+        for( path const& entry : directory_iterator(dir) )
+        {
+            std::string filename = entry.filename().string();
+            if( std::regex_search(filename, pattern) )
+                files.emplace_back(filename);
+        }
+
+        if( writeIdx )
+            writeIndex(files, directoryTime, scanTime);
+    }
+
+    std::unique_ptr< FilePrefetcher > prefetcher;
+    if( prefetch && files.size() > 1 )
+        prefetcher.reset(new FilePrefetcher(IOHandler->directory, files));
 
     Parameter< Operation::OPEN_FILE > fOpen;
     Parameter< Operation::READ_ATT > aRead;
 
-    using namespace boost::filesystem;
-    path dir(IOHandler->directory);
-    for( path const& entry : directory_iterator(dir) )
+    for( std::string const& filename : files )
     {
-        if( std::regex_search(entry.filename().string(), pattern) )
+        if( std::regex_search(filename, match, pattern) )
         {
-            fOpen.name = entry.filename().string();
+            if( lazy && headerRead )
+            {
+                /* the series-level metadata is identical in every file */
+                uint64_t index = std::stoull(match[1]);
+                if( iterations.count(index) == 0 )
+                    iterations[index].deferRead(filename, std::to_string(index));
+                continue;
+            }
+
+            fOpen.name = filename;
             IOHandler->enqueue(IOTask(this, fOpen));
             IOHandler->flush();
             iterations.parent = this;
@@ -441,17 +625,26 @@ Series::readFileBased()
             else
                 throw std::runtime_error("Unexpected Attribute datatype for 'iterationFormat'");
 
-            read();
+            read(lazy);
+            if( lazy )
+            {
+                for( auto& i : iterations.m_container )
+                    if( i.second.m_deferred )
+                        i.second.m_deferredFile = filename;
+                headerRead = true;
+            }
         }
     }
 
     /* this file need not be flushed */
     iterations.written = true;
     written = true;
+    iterations.dirtyRecursive = false;
+    dirtyRecursive = false;
 }
 
 void
-Series::readGroupBased()
+Series::readGroupBased(bool lazy)
 {
     Parameter< Operation::OPEN_FILE > fOpen;
     fOpen.name = m_name;
@@ -497,11 +690,13 @@ Series::readGroupBased()
      * at this point we can guarantee clearing the container won't break anything */
     iterations.clear_unchecked();
 
-    read();
+    read(lazy);
 
     /* this file need not be flushed */
     iterations.written = true;
     written = true;
+    iterations.dirtyRecursive = false;
+    dirtyRecursive = false;
 }
 
 void
@@ -552,7 +747,7 @@ Series::readBase()
 }
 
 void
-Series::read()
+Series::read(bool lazy)
 {
     Parameter< Operation::OPEN_PATH > pOpen;
     std::string version = openPMD();
@@ -573,6 +768,12 @@ Series::read()
     for( auto const& it : *pList.paths )
     {
         Iteration& i = iterations[std::stoull(it)];
+        if( lazy )
+        {
+            i.deferRead("", it);
+            continue;
+        }
+
         pOpen.path = it;
         IOHandler->enqueue(IOTask(&i, pOpen));
         IOHandler->flush();
@@ -582,6 +783,101 @@ Series::read()
     readAttributes();
 }
 
+/* The index of a fileBased series is a binary file holding
+ *   char[8]   magic "openPMDi"
+ *   uint32_t  format version
+ *   int64_t   modification time of the directory before it was scanned
+ *   int64_t   time the scan started
+ *   uint64_t  number of files, followed by each file name as (uint64_t length, chars)
+ * Modification times are only available in seconds, hence an index scanned within
+ * the same second as the last modification of the directory is not trusted.
+ * The index is a hidden file inside the directory of the series. It is created before
+ * the directory is scanned and afterwards only overwritten in place, which does not
+ * modify the directory it describes. */
+static constexpr char const INDEX_MAGIC[8] = {'o', 'p', 'e', 'n', 'P', 'M', 'D', 'i'};
+static constexpr uint32_t INDEX_VERSION = 1;
+
+std::string
+Series::indexPath() const
+{
+    return IOHandler->directory + "." + m_name + ".index";
+}
+
+bool
+Series::createIndex() const
+{
+    /* opening for appending creates a missing index without truncating an existing one */
+    std::ofstream out(indexPath(), std::ios::binary | std::ios::app);
+    return static_cast< bool >(out);
+}
+
+bool
+Series::readIndex(std::vector< std::string >& files) const
+{
+    std::ifstream in(indexPath(), std::ios::binary);
+    if( !in )
+        return false;
+
+    char magic[8];
+    uint32_t version;
+    int64_t directoryTime, scanTime;
+    uint64_t numFiles;
+    in.read(magic, sizeof(magic));
+    in.read(reinterpret_cast< char* >(&version), sizeof(version));
+    in.read(reinterpret_cast< char* >(&directoryTime), sizeof(directoryTime));
+    in.read(reinterpret_cast< char* >(&scanTime), sizeof(scanTime));
+    in.read(reinterpret_cast< char* >(&numFiles), sizeof(numFiles));
+    if( !in || !std::equal(magic, magic + sizeof(magic), INDEX_MAGIC) || version != INDEX_VERSION )
+        return false;
+
+    boost::system::error_code ec;
+    std::time_t current = boost::filesystem::last_write_time(IOHandler->directory, ec);
+    if( ec || static_cast< int64_t >(current) != directoryTime || directoryTime >= scanTime )
+        return false;
+
+    std::vector< std::string > ret;
+    ret.reserve(numFiles);
+    for( uint64_t i = 0; i < numFiles; ++i )
+    {
+        uint64_t length;
+        in.read(reinterpret_cast< char* >(&length), sizeof(length));
+        if( !in )
+            return false;
+        std::string name(length, '\0');
+        in.read(&name[0], length);
+        if( !in )
+            return false;
+        ret.emplace_back(std::move(name));
+    }
+
+    files = std::move(ret);
+    return true;
+}
+
+void
+Series::writeIndex(std::vector< std::string > const& files, int64_t directoryTime, int64_t scanTime) const
+{
+    std::ofstream out(indexPath(), std::ios::binary | std::ios::trunc);
+    if( !out )
+        throw std::runtime_error("Could not open the index " + indexPath() + " for writing");
+
+    uint64_t numFiles = files.size();
+    out.write(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    out.write(reinterpret_cast< char const* >(&INDEX_VERSION), sizeof(INDEX_VERSION));
+    out.write(reinterpret_cast< char const* >(&directoryTime), sizeof(directoryTime));
+    out.write(reinterpret_cast< char const* >(&scanTime), sizeof(scanTime));
+    out.write(reinterpret_cast< char const* >(&numFiles), sizeof(numFiles));
+    for( std::string const& name : files )
+    {
+        uint64_t length = name.size();
+        out.write(reinterpret_cast< char const* >(&length), sizeof(length));
+        out.write(name.data(), length);
+    }
+    out.close();
+    if( !out )
+        throw std::runtime_error("Could not write the index " + indexPath());
+}
+
 std::string
 Series::cleanFilename(std::string s, Format f)
 {
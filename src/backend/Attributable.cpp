@@ -19,25 +19,27 @@
  * If not, see <http://www.gnu.org/licenses/>.
  */
 #include <iostream>
-#include <set>
 
 #include "backend/Attributable.hpp"
 #include "auxiliary/StringManip.hpp"
 
 Attributable::Attributable()
-        : m_attributes{std::make_shared< A_MAP >()}
+        : m_attributes{std::make_shared< A_MAP >()},
+          m_dirtyAttributes{std::make_shared< A_SET >()}
 { }
 
 Attributable::Attributable(Attributable const& rhs)
 // Deep-copy the entries in the Attribute map since the lifetime of the rhs does not end
         : Writable{rhs},
-          m_attributes{std::make_shared< A_MAP >(*rhs.m_attributes)}
+          m_attributes{std::make_shared< A_MAP >(*rhs.m_attributes)},
+          m_dirtyAttributes{std::make_shared< A_SET >(*rhs.m_dirtyAttributes)}
 { }
 
 Attributable::Attributable(Attributable&& rhs)
 // Take ownership of the Attribute map pointer since the lifetime of the rhs does end
         : Writable{rhs},
-          m_attributes{std::move(rhs.m_attributes)}
+          m_attributes{std::move(rhs.m_attributes)},
+          m_dirtyAttributes{std::move(rhs.m_dirtyAttributes)}
 { }
 
 Attributable&
@@ -47,6 +49,7 @@ Attributable::operator=(Attributable const& a)
     {
         Attributable tmp(a);
         std::swap(m_attributes, tmp.m_attributes);
+        std::swap(m_dirtyAttributes, tmp.m_dirtyAttributes);
     }
     return *this;
 }
@@ -55,6 +58,7 @@ Attributable&
 Attributable::operator=(Attributable&& a)
 {
     m_attributes = std::move(a.m_attributes);
+    m_dirtyAttributes = std::move(a.m_dirtyAttributes);
     return *this;
 }
 
@@ -82,6 +86,7 @@ Attributable::deleteAttribute(std::string const& key)
         IOHandler->enqueue(IOTask(this, aDelete));
         IOHandler->flush();
         m_attributes->erase(it);
+        m_dirtyAttributes->erase(key);
         return true;
     }
     return false;
@@ -123,15 +128,19 @@ Attributable::flushAttributes()
     if( dirty )
     {
         Parameter< Operation::WRITE_ATT > aWrite;
-        for( std::string const & att_name : attributes() )
+        for( auto const& att : *m_attributes )
         {
-            aWrite.name = att_name;
-            aWrite.resource = getAttribute(att_name).getResource();
-            aWrite.dtype = getAttribute(att_name).dtype;
+            /* unmodified Attributes are already present in written objects */
+            if( written && m_dirtyAttributes->count(att.first) == 0 )
+                continue;
+
+            aWrite.name = att.first;
+            aWrite.resource = att.second.getResource();
+            aWrite.dtype = att.second.dtype;
             IOHandler->enqueue(IOTask(this, aWrite));
-            IOHandler->flush();
         }
 
+        m_dirtyAttributes->clear();
         dirty = false;
     }
 }
@@ -139,41 +148,22 @@ Attributable::flushAttributes()
 void
 Attributable::readAttributes()
 {
-    Parameter< Operation::LIST_ATTS > aList;
-    IOHandler->enqueue(IOTask(this, aList));
+    /* all attributes of this object are retrieved in a single operation,
+     * unsupported attributes are skipped by the backend */
+    Parameter< Operation::READ_ALL_ATTS > aRead;
+    IOHandler->enqueue(IOTask(this, aRead));
     IOHandler->flush();
-    std::vector< std::string > written_attributes = attributes();
-
-    /* std::set_difference requires sorted ranges */
-    std::sort(aList.attributes->begin(), aList.attributes->end());
-    std::sort(written_attributes.begin(), written_attributes.end());
-
-    std::set< std::string > attributes;
-    std::set_difference(aList.attributes->begin(), aList.attributes->end(),
-                        written_attributes.begin(), written_attributes.end(),
-                        std::inserter(attributes, attributes.begin()));
 
     using DT = Datatype;
-    Parameter< Operation::READ_ATT > aRead;
-
-    for( auto const& att_name : attributes )
+    for( auto const& entry : *aRead.attributes )
     {
-        aRead.name = att_name;
-        std::string att = strip(att_name, {'\0'});
-        IOHandler->enqueue(IOTask(this, aRead));
-        try
-        {
-            IOHandler->flush();
-        } catch( unsupported_data_error e )
-        {
-            std::cerr << "Skipping non-standard attribute "
-                      << att << " ("
-                      << e.what()
-                      << ")\n";
+        /* attributes that have already been read explicitly are kept */
+        if( m_attributes->count(entry.first) != 0 )
             continue;
-        }
-        Attribute a(*aRead.resource);
-        switch( *aRead.dtype )
+
+        std::string att = strip(entry.first, {'\0'});
+        Attribute const& a = entry.second;
+        switch( a.dtype )
         {
             case DT::CHAR:
                 setAttribute(att, a.get< char >());
@@ -259,7 +249,7 @@ Attributable::readAttributes()
         }
     }
 
-    IOHandler->flush();
+    m_dirtyAttributes->clear();
     dirty = false;
 }
 
@@ -33,6 +33,7 @@ MeshRecordComponent::read()
 
     /* this file need not be flushed */
     written = true;
+    dirtyRecursive = false;
 }
 
 template< typename T >
@@ -27,10 +27,15 @@ PatchRecord::PatchRecord()
 void
 PatchRecord::flush(std::string const& path)
 {
+    if( written && !isDirtyRecursive() )
+        return;
+
     Container< PatchRecordComponent >::flush(path);
 
     for( auto& comp : *this )
         comp.second.flush(comp.first);
+
+    dirtyRecursive = false;
 }
 
 void
@@ -58,5 +63,8 @@ PatchRecord::read()
         dRead.data = data.get();
         IOHandler->enqueue(IOTask(&prc, dRead));
         IOHandler->flush();
+        prc.dirtyRecursive = false;
     }
+
+    dirtyRecursive = false;
 }
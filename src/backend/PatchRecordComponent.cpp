@@ -32,5 +32,4 @@ PatchRecordComponent::flush(std::string const& name)
         dCreate.transform = m_dataset.transform;
         IOHandler->enqueue(IOTask(this, dCreate));
     }
-    IOHandler->flush();
 }
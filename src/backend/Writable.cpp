@@ -6,9 +6,17 @@ Writable::Writable()
           parent{nullptr},
           IOHandler{nullptr},
           dirty{true},
+          dirtyRecursive{true},
           written{false}
 { }
 
 Writable::~Writable()
 { }
 
+void
+Writable::setDirtyRecursive()
+{
+    for( Writable* w = this; w; w = w->parent )
+        w->dirtyRecursive = true;
+}
+
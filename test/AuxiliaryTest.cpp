@@ -236,3 +236,48 @@ BOOST_AUTO_TEST_CASE(dot_test)
     BOOST_TEST(d.att3() == "30");
 
 }
+
+class RecordingIOHandler : public AbstractIOHandler
+{
+public:
+    RecordingIOHandler()
+            : AbstractIOHandler("", AccessType::CREATE)
+    { }
+
+    std::future< void > flush() override
+    {
+        while( !m_work.empty() )
+        {
+            if( m_work.front().operation == Operation::WRITE_ATT )
+                writtenAttributes.push_back(m_work.front().get< Operation::WRITE_ATT >().name);
+            m_work.pop();
+        }
+        return std::future< void >();
+    }
+
+    std::vector< std::string > writtenAttributes;
+};
+
+BOOST_AUTO_TEST_CASE(attributable_dirty_test)
+{
+    auto handler = std::make_shared< RecordingIOHandler >();
+    Dotty d;
+    d.IOHandler = handler;
+
+    d.flushAttributes();
+    handler->flush();
+    BOOST_TEST(handler->writtenAttributes.size() == 3);
+
+    /* only modified attributes of written objects are written again */
+    d.written = true;
+    handler->writtenAttributes.clear();
+    d.setAtt2(20);
+    d.flushAttributes();
+    handler->flush();
+    BOOST_TEST(handler->writtenAttributes == std::vector< std::string >{"att2"});
+
+    handler->writtenAttributes.clear();
+    d.flushAttributes();
+    handler->flush();
+    BOOST_TEST(handler->writtenAttributes.empty());
+}
@@ -319,6 +319,105 @@ BOOST_AUTO_TEST_CASE(recordComponent_modification_test)
     BOOST_TEST(r["z"].numAttributes() == 1); /* unitSI */
 }
 
+BOOST_AUTO_TEST_CASE(recordComponent_constant_load_test)
+{
+    using IE = IterationEncoding;
+    Series o = Series::create("./",
+                              "MyOutput_%T",
+                              IE::fileBased,
+                              Format::DUMMY,
+                              AccessType::CREATE);
+
+    /* constant values are served from memory without any IO */
+    RecordComponent& rc = o.iterations[42].particles["species"]["positionOffset"]["x"];
+    rc.makeConstant(static_cast< float >(0.5));
+    rc.resetDataset(Dataset(Datatype::FLOAT, {4, 1024, 1024}));
+
+    std::unique_ptr< double[] > data;
+    rc.loadChunk({0, 0, 0}, {4, 1024, 1024}, data, RecordComponent::Allocation::API);
+    BOOST_TEST(data[0] == 0.5);
+    BOOST_TEST(data[2 * 1024 * 1024] == 0.5);
+    BOOST_TEST(data[4 * 1024 * 1024 - 1] == 0.5);
+}
+
+BOOST_AUTO_TEST_CASE(integer_unit_scaling_test)
+{
+    /* integer factors keep 64 bit values exact */
+    int64_t large[3] = {(int64_t(1) << 53) + 1, -((int64_t(1) << 60) + 3), 7};
+    scaleElements(large, 3, 4.);
+    BOOST_TEST(large[0] == (int64_t(1) << 55) + 4);
+    BOOST_TEST(large[1] == -((int64_t(1) << 62) + 12));
+    BOOST_TEST(large[2] == 28);
+
+    /* as do reciprocals of integers, rounding half away from zero */
+    uint64_t huge[3] = {std::numeric_limits< uint64_t >::max(), 1500, 1499};
+    scaleElements(huge, 3, 1e-3);
+    BOOST_TEST(huge[0] == 18446744073709552u);
+    BOOST_TEST(huge[1] == 2u);
+    BOOST_TEST(huge[2] == 1u);
+    int64_t negative[2] = {-1500, std::numeric_limits< int64_t >::min()};
+    scaleElements(negative, 2, 0.5);
+    BOOST_TEST(negative[0] == -750);
+    BOOST_TEST(negative[1] == std::numeric_limits< int64_t >::min() / 2);
+
+    /* results beyond the range of the type saturate */
+    int64_t overflow[4] = {std::numeric_limits< int64_t >::max(), -2, 3, std::numeric_limits< int64_t >::min()};
+    scaleElements(overflow, 4, 1e19);
+    BOOST_TEST(overflow[0] == std::numeric_limits< int64_t >::max());
+    BOOST_TEST(overflow[1] == std::numeric_limits< int64_t >::min());
+    BOOST_TEST(overflow[2] == std::numeric_limits< int64_t >::max());
+    BOOST_TEST(overflow[3] == std::numeric_limits< int64_t >::min());
+    uint64_t beyond[2] = {2, 3};
+    scaleElements(beyond, 2, 1e30);
+    BOOST_TEST(beyond[0] == std::numeric_limits< uint64_t >::max());
+    scaleElements(beyond + 1, 1, -1.);
+    BOOST_TEST(beyond[1] == 0u);
+    int16_t small[2] = {1000, -1000};
+    scaleElements(small, 2, 40.5);
+    BOOST_TEST(small[0] == std::numeric_limits< int16_t >::max());
+    BOOST_TEST(small[1] == std::numeric_limits< int16_t >::min());
+    uint8_t bytes[2] = {200, 3};
+    scaleElements(bytes, 2, 1.25);
+    BOOST_TEST(bytes[0] == 250u);
+    BOOST_TEST(bytes[1] == 4u);
+
+    BOOST_CHECK_THROW(scaleElements(small, 2, std::numeric_limits< double >::infinity()), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(dataset_automatic_chunk_test)
+{
+    Dataset field(Datatype::DOUBLE, {1024, 1024});
+    BOOST_TEST(field.chunkSize.empty());
+    BOOST_TEST(field.automaticChunkSize() == Extent({256, 512}));
+
+    /* slices along the first dimension stay whole as long as they fit */
+    Dataset volume(Datatype::FLOAT, {64, 256, 256});
+    volume.setAutomaticChunking(Dataset::DEFAULT_CHUNK_BYTES, Dataset::ChunkAccess::SLICE);
+    BOOST_TEST(volume.automaticChunkSize() == Extent({4, 256, 256}));
+
+    BOOST_TEST(Dataset(Datatype::FLOAT, {10, 10}).automaticChunkSize() == Extent({10, 10}));
+    BOOST_TEST(Dataset(Datatype::INT32, {0}).automaticChunkSize() == Extent({1}));
+
+    BOOST_CHECK_THROW(field.setChunkSize({0, 16}), std::runtime_error);
+    BOOST_CHECK_THROW(field.setChunkSize({16}), std::runtime_error);
+    BOOST_CHECK_THROW(field.setAutomaticChunking(0), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(dataset_layout_test)
+{
+    /* fixed-size datasets without filters are stored contiguously unless asked otherwise */
+    BOOST_TEST((Dataset(Datatype::DOUBLE, {100}).resolvedLayout() == Dataset::Layout::CONTIGUOUS));
+    BOOST_TEST((Dataset(Datatype::DOUBLE, {0}).resolvedLayout() == Dataset::Layout::CHUNKED));
+    BOOST_TEST((Dataset(Datatype::DOUBLE, {100}).setChunkSize({10}).resolvedLayout() == Dataset::Layout::CHUNKED));
+    BOOST_TEST((Dataset(Datatype::DOUBLE, {100}).addFilter(Dataset::Filter::shuffle()).resolvedLayout() == Dataset::Layout::CHUNKED));
+
+    Dataset compact(Datatype::DOUBLE, {100});
+    compact.setLayout(Dataset::Layout::COMPACT);
+    BOOST_TEST((compact.resolvedLayout() == Dataset::Layout::COMPACT));
+    compact.addFilter(Dataset::Filter::deflate(1));
+    BOOST_CHECK_THROW(compact.resolvedLayout(), std::runtime_error);
+}
+
 BOOST_AUTO_TEST_CASE(mesh_constructor_test)
 {
     using IE = IterationEncoding;
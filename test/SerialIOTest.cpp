@@ -1,7 +1,14 @@
 #define BOOST_TEST_MODULE libopenpmd_serial_io_test
 
 
+#include <boost/filesystem.hpp>
 #include <boost/test/included/unit_test.hpp>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#ifdef LIBOPENPMD_WITH_HDF5
+#   include <hdf5.h>
+#endif
 
 /* make Writable::parent visible for hierarchy check */
 #define protected public
@@ -796,6 +803,706 @@ BOOST_AUTO_TEST_CASE(hdf5_write_test)
     //TODO close file, read back, verify
 }
 
+BOOST_AUTO_TEST_CASE(hdf5_copy_on_store_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_copy_on_store.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+        o.setCopyOnStore(1024);
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {8}));
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::UINT64, {512}));
+
+        /* the buffer of the caller is released and can be reused right away */
+        std::shared_ptr< double > position(new double[4]{0., 1., 2., 3.}, [](double* p){ delete[] p; });
+        e["position"]["x"].storeChunk({0}, {4}, position);
+        BOOST_TEST(position.use_count() == 1);
+        std::fill(position.get(), position.get() + 4, -1.);
+
+        /* chunks exceeding the capacity of the pool are copied as well */
+        std::shared_ptr< uint64_t > positionOffset(new uint64_t[512], [](uint64_t* p){ delete[] p; });
+        std::fill(positionOffset.get(), positionOffset.get() + 512, 7u);
+        e["positionOffset"]["x"].storeChunk({0}, {512}, positionOffset);
+        BOOST_TEST(positionOffset.use_count() == 1);
+        std::fill(positionOffset.get(), positionOffset.get() + 512, 0u);
+
+        o.flush();
+
+        /* written staging buffers are recycled */
+        size_t allocated = o.IOHandler->stagingBuffers->allocated();
+        e["position"]["x"].storeChunk({4}, {4}, position);
+        BOOST_TEST(o.IOHandler->stagingBuffers->allocated() == allocated);
+        BOOST_TEST(allocated <= o.IOHandler->stagingBuffers->capacity());
+    }
+
+    Series i = Series::read("samples",
+                            "serial_copy_on_store.h5");
+    std::unique_ptr< double[] > position;
+    i.iterations[1].particles["e"]["position"]["x"].loadChunk({0}, {8}, position, RecordComponent::Allocation::API);
+    for( uint64_t j = 0; j < 4; ++j )
+    {
+        BOOST_TEST(position[j] == static_cast< double >(j));
+        BOOST_TEST(position[j + 4] == -1.);
+    }
+    std::unique_ptr< uint64_t[] > positionOffset;
+    i.iterations[1].particles["e"]["positionOffset"]["x"].loadChunk({0}, {512}, positionOffset, RecordComponent::Allocation::API);
+    BOOST_TEST(positionOffset[0] == 7u);
+    BOOST_TEST(positionOffset[511] == 7u);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_copy_on_store_exhausted_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_copy_on_store_exhausted.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+        o.setCopyOnStore(1024);
+
+        RecordComponent& x = o.iterations[1].particles["e"]["position"]["x"];
+        x.resetDataset(Dataset(Datatype::DOUBLE, {256}));
+
+        /* the chunks stored in total exceed the capacity of the pool */
+        std::shared_ptr< double > source(new double[64], [](double* p){ delete[] p; });
+        for( uint64_t i = 0; i < 4; ++i )
+        {
+            std::fill(source.get(), source.get() + 64, static_cast< double >(i));
+            x.storeChunk({64 * i}, {64}, source);
+            BOOST_TEST(source.use_count() == 1);
+            BOOST_TEST(o.IOHandler->stagingBuffers->allocated() <= o.IOHandler->stagingBuffers->capacity());
+        }
+        std::fill(source.get(), source.get() + 64, -1.);
+    }
+
+    Series i = Series::read("samples",
+                            "serial_copy_on_store_exhausted.h5");
+    std::unique_ptr< double[] > position;
+    i.iterations[1].particles["e"]["position"]["x"].loadChunk({0}, {256}, position, RecordComponent::Allocation::API);
+    for( uint64_t j = 0; j < 256; ++j )
+        BOOST_TEST(position[j] == static_cast< double >(j / 64));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_max_pending_bytes_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_max_pending_bytes.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+        o.setMaxPendingBytes(2 * sizeof(double));
+
+        RecordComponent& x = o.iterations[1].particles["e"]["position"]["x"];
+        x.resetDataset(Dataset(Datatype::DOUBLE, {4}));
+
+        std::vector< std::shared_ptr< double > > chunks;
+        for( uint64_t i = 0; i < 4; ++i )
+        {
+            chunks.emplace_back(new double(static_cast< double >(i)));
+            x.storeChunk({i}, {1}, chunks.back());
+        }
+
+        /* the third chunk exceeded the limit and flushed all three */
+        BOOST_TEST(o.pendingBytes() == sizeof(double));
+        BOOST_TEST(chunks[0].use_count() == 1);
+        BOOST_TEST(chunks[2].use_count() == 1);
+        BOOST_TEST(chunks[3].use_count() == 2);
+
+        o.flush();
+        BOOST_TEST(o.pendingBytes() == 0u);
+
+        /* chunks of an erased component are discarded */
+        Record& position = o.iterations[1].particles["e"]["position"];
+        RecordComponent& y = position["y"];
+        y.resetDataset(Dataset(Datatype::DOUBLE, {4}));
+        y.storeChunk({0}, {1}, chunks[0]);
+        BOOST_TEST(o.pendingBytes() == sizeof(double));
+        position.erase("y");
+        BOOST_TEST(o.pendingBytes() == 0u);
+
+        /* only the components with the most pending bytes are written */
+        RecordComponent& z = position["z"];
+        z.resetDataset(Dataset(Datatype::DOUBLE, {4}));
+        o.flush();
+        o.setMaxPendingBytes(3 * sizeof(double));
+        o.iterations[1].setTime(1.);
+        std::shared_ptr< double > triple(new double[3]{4., 5., 6.}, [](double* p){ delete[] p; });
+        z.storeChunk({0}, {3}, triple);
+        x.storeChunk({0}, {1}, chunks[0]);
+        x.storeChunk({1}, {1}, chunks[1]);
+        BOOST_TEST(o.pendingBytes() == 2 * sizeof(double));
+        BOOST_TEST(triple.use_count() == 1);
+        BOOST_TEST(chunks[0].use_count() == 2);
+        BOOST_TEST(chunks[1].use_count() == 2);
+        /* the rest of the series is left for the next flush */
+        BOOST_TEST(o.iterations[1].dirty);
+    }
+
+    Series i = Series::read("samples",
+                            "serial_max_pending_bytes.h5");
+    std::unique_ptr< double[] > position;
+    i.iterations[1].particles["e"]["position"]["x"].loadChunk({0}, {4}, position, RecordComponent::Allocation::API);
+    for( uint64_t j = 0; j < 4; ++j )
+        BOOST_TEST(position[j] == static_cast< double >(j));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_memory_layout_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_memory_layout.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+
+        /* 2x3 field surrounded by one guard cell */
+        Mesh& rho = o.iterations[1].meshes["rho"];
+        rho.setGridSpacing(std::vector< double >{1, 1});
+        rho.setGridGlobalOffset(std::vector< double >{0, 0});
+        rho.setAxisLabels({"x", "y"});
+        MeshRecordComponent& r = rho[RecordComponent::SCALAR];
+        r.setPosition(std::vector< double >{0, 0});
+        r.resetDataset(Dataset(Datatype::INT32, {2, 3}));
+        std::shared_ptr< int32_t > field(new int32_t[4 * 5], [](int32_t* p){ delete[] p; });
+        for( int32_t j = 0; j < 4 * 5; ++j )
+            field.get()[j] = j;
+        r.storeChunk({0, 0}, {2, 3}, field, MemoryLayout({4, 5}, {1, 1}));
+
+        /* array of structs holding the three components of each particle */
+        struct Particle { double x, y, z; };
+        std::shared_ptr< Particle > particles(new Particle[4], [](Particle* p){ delete[] p; });
+        for( int j = 0; j < 4; ++j )
+            particles.get()[j] = Particle{static_cast< double >(j), 10. + j, 20. + j};
+        std::shared_ptr< double > members(particles, reinterpret_cast< double* >(particles.get()));
+        Record& position = o.iterations[1].particles["e"]["position"];
+        for( auto const& component : {"x", "y", "z"} )
+            position[component].resetDataset(Dataset(Datatype::DOUBLE, {4}));
+        position["x"].storeChunk({0}, {4}, members, MemoryLayout({12}, {0}, {3}));
+        position["y"].storeChunk({0}, {4}, members, MemoryLayout({12}, {1}, {3}));
+        position["z"].storeChunk({0}, {4}, members, MemoryLayout({12}, {2}, {3}));
+    }
+
+    Series i = Series::read("samples",
+                            "serial_memory_layout.h5");
+    std::unique_ptr< int32_t[] > dense;
+    MeshRecordComponent& r = i.iterations[1].meshes["rho"][RecordComponent::SCALAR];
+    r.loadChunk({0, 0}, {2, 3}, dense, RecordComponent::Allocation::API);
+    BOOST_TEST(dense[0] == 6);
+    BOOST_TEST(dense[2] == 8);
+    BOOST_TEST(dense[3] == 11);
+    BOOST_TEST(dense[5] == 13);
+
+    /* read back into the guard cell layout, leaving the guard cells untouched */
+    std::shared_ptr< int32_t > field(new int32_t[4 * 5], [](int32_t* p){ delete[] p; });
+    std::fill(field.get(), field.get() + 4 * 5, -1);
+    r.loadChunk({0, 0}, {2, 3}, field, MemoryLayout({4, 5}, {1, 1}));
+    for( int32_t j = 0; j < 4 * 5; ++j )
+    {
+        bool inside = j / 5 >= 1 && j / 5 <= 2 && j % 5 >= 1 && j % 5 <= 3;
+        BOOST_TEST(field.get()[j] == (inside ? j : -1));
+    }
+
+    std::shared_ptr< double > members(new double[12], [](double* p){ delete[] p; });
+    Record& position = i.iterations[1].particles["e"]["position"];
+    position["y"].loadChunk({0}, {4}, members, MemoryLayout({12}, {1}, {3}));
+    for( int j = 0; j < 4; ++j )
+        BOOST_TEST(members.get()[3 * j + 1] == 10. + j);
+
+    BOOST_CHECK_THROW(position["y"].loadChunk({0}, {4}, members, MemoryLayout({12}, {1}, {4})), std::runtime_error);
+
+    /* assemble a padded array from one read per row */
+    std::vector< int32_t > padded(4 * 5, -1);
+    for( uint64_t row = 0; row < 2; ++row )
+        r.loadChunk({row, 0}, {1, 3}, padded.data(), {4, 5}, {row + 1, 1});
+    for( int32_t j = 0; j < 4 * 5; ++j )
+    {
+        bool inside = j / 5 >= 1 && j / 5 <= 2 && j % 5 >= 1 && j % 5 <= 3;
+        BOOST_TEST(padded[j] == (inside ? j : -1));
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_unit_scaling_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_unit_scaling.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+
+        /* large enough to be read in several slabs */
+        Record& position = o.iterations[1].particles["e"]["position"];
+        position["x"].setUnitSI(2.);
+        position["x"].resetDataset(Dataset(Datatype::DOUBLE, {1024, 640}));
+        std::shared_ptr< double > x(new double[1024 * 640], [](double* p){ delete[] p; });
+        for( size_t j = 0; j < 1024 * 640; ++j )
+            x.get()[j] = static_cast< double >(j);
+        position["x"].storeChunk({0, 0}, {1024, 640}, x);
+
+        position["y"].setUnitSI(0.5);
+        position["y"].resetDataset(Dataset(Datatype::INT32, {4}));
+        std::shared_ptr< int32_t > y(new int32_t[4]{1, 2, 3, 4}, [](int32_t* p){ delete[] p; });
+        position["y"].storeChunk({0}, {4}, y);
+
+        o.iterations[1].particles["e"]["positionOffset"]["x"].setUnitSI(3.).makeConstant(1.5);
+        o.iterations[1].particles["e"]["positionOffset"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {4}));
+    }
+
+    Series i = Series::read("samples",
+                            "serial_unit_scaling.h5");
+    Record& position = i.iterations[1].particles["e"]["position"];
+
+    std::unique_ptr< double[] > x;
+    position["x"].loadChunk({0, 0}, {1024, 640}, x, RecordComponent::Allocation::API, 1.);
+    BOOST_TEST(x[0] == 0.);
+    BOOST_TEST(x[1] == 2.);
+    BOOST_TEST(x[1024 * 640 - 1] == 2. * (1024 * 640 - 1));
+
+    /* stored unit without target */
+    position["x"].loadChunk({1, 0}, {1, 640}, x, RecordComponent::Allocation::USER);
+    BOOST_TEST(x[0] == 640.);
+
+    std::unique_ptr< int32_t[] > y;
+    position["y"].loadChunk({0}, {4}, y, RecordComponent::Allocation::API, 0.25);
+    BOOST_TEST(y[0] == 2);
+    BOOST_TEST(y[3] == 8);
+
+    std::vector< double > padded(6, -1.);
+    position["x"].loadChunk({0, 1}, {1, 2}, padded.data(), {1, 6}, {0, 2}, 4.);
+    BOOST_TEST(padded[1] == -1.);
+    BOOST_TEST(padded[2] == 0.5);
+    BOOST_TEST(padded[3] == 1.);
+    BOOST_TEST(padded[4] == -1.);
+
+    std::unique_ptr< double[] > offset;
+    i.iterations[1].particles["e"]["positionOffset"]["x"].loadChunk({0}, {4}, offset, RecordComponent::Allocation::API, 1.);
+    BOOST_TEST(offset[3] == 4.5);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_dtype_conversion_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_dtype_conversion.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+
+        /* double precision in memory, single precision on disk */
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["position"]["x"].resetDataset(Dataset(Datatype::FLOAT, {4}));
+        std::shared_ptr< double > x(new double[4]{0.5, 1.5, 2.5, 3.5}, [](double* p){ delete[] p; });
+        e["position"]["x"].storeChunk({0}, {4}, x);
+
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::INT16, {4}));
+        std::shared_ptr< int64_t > offset(new int64_t[4]{-1, 2, 100000, 4}, [](int64_t* p){ delete[] p; });
+        e["positionOffset"]["x"].storeChunk({0}, {4}, offset);
+
+        e["charge"][RecordComponent::SCALAR].makeConstant(static_cast< float >(-1.));
+        e["charge"][RecordComponent::SCALAR].resetDataset(Dataset(Datatype::FLOAT, {4}));
+
+        std::shared_ptr< bool > flags(new bool[4](), [](bool* p){ delete[] p; });
+        BOOST_CHECK_THROW(e["position"]["x"].storeChunk({0}, {4}, flags), std::runtime_error);
+    }
+
+    Series i = Series::read("samples",
+                            "serial_dtype_conversion.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+    BOOST_TEST(e["position"]["x"].getDatatype() == Datatype::FLOAT);
+
+    std::unique_ptr< double[] > x;
+    e["position"]["x"].loadChunk({0}, {4}, x, RecordComponent::Allocation::API);
+    BOOST_TEST(x[0] == 0.5);
+    BOOST_TEST(x[3] == 3.5);
+
+    std::unique_ptr< int64_t[] > offset;
+    e["positionOffset"]["x"].loadChunk({0}, {4}, offset, RecordComponent::Allocation::API);
+    BOOST_TEST(offset[0] == -1);
+    BOOST_TEST(offset[2] == std::numeric_limits< int16_t >::max());
+
+    std::unique_ptr< double[] > charge;
+    e["charge"][RecordComponent::SCALAR].loadChunk({0}, {4}, charge, RecordComponent::Allocation::API);
+    BOOST_TEST(charge[3] == -1.);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_filter_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_filter.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        Dataset d(Datatype::DOUBLE, {64});
+        d.addFilter(Dataset::Filter::shuffle())
+         .addFilter(Dataset::Filter::deflate(6))
+         .addFilter(Dataset::Filter::fletcher32());
+        e["position"]["x"].resetDataset(d);
+        std::shared_ptr< double > x(new double[64], [](double* p){ delete[] p; });
+        for( int i = 0; i < 64; ++i )
+            x.get()[i] = 0.5 * i;
+        e["position"]["x"].storeChunk({0}, {64}, x);
+
+        /* filter IDs 256-511 are reserved for testing and never registered */
+        Dataset unavailable(Datatype::DOUBLE, {64});
+        unavailable.addFilter(Dataset::Filter(300, {}, true));
+        e["positionOffset"]["x"].resetDataset(unavailable);
+        e["positionOffset"]["x"].storeChunk({0}, {64}, x);
+
+        /* built-in filters are optional as well, e.g. szip without an encoder in the library */
+        Dataset::Filter szip = Dataset::Filter::szip();
+        szip.optional = true;
+        Dataset maybeSzip(Datatype::DOUBLE, {64});
+        maybeSzip.addFilter(szip);
+        e["momentum"]["x"].resetDataset(maybeSzip);
+        e["momentum"]["x"].storeChunk({0}, {64}, x);
+    }
+
+    Series i = Series::read("samples",
+                            "serial_filter.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+    std::vector< Dataset::Filter > filters = e["position"]["x"].getFilters();
+    BOOST_REQUIRE(filters.size() == 3);
+    BOOST_TEST(filters[0].id == Dataset::Filter::shuffle().id);
+    BOOST_TEST(filters[1].id == Dataset::Filter::deflate(6).id);
+    BOOST_TEST(filters[1].parameters == std::vector< unsigned int >{6});
+    BOOST_TEST(filters[2].id == Dataset::Filter::fletcher32().id);
+    BOOST_TEST(e["positionOffset"]["x"].getFilters().empty());
+
+    std::unique_ptr< double[] > x;
+    e["position"]["x"].loadChunk({0}, {64}, x, RecordComponent::Allocation::API);
+    std::unique_ptr< double[] > momentum;
+    e["momentum"]["x"].loadChunk({0}, {64}, momentum, RecordComponent::Allocation::API);
+    i.flush();
+    BOOST_TEST(x[0] == 0.);
+    BOOST_TEST(x[63] == 31.5);
+    BOOST_TEST(momentum[63] == 31.5);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_chunk_size_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_chunk_size.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        Dataset automatic(Datatype::DOUBLE, {1000});
+        automatic.setAutomaticChunking(1024);
+        e["position"]["x"].resetDataset(automatic);
+        Dataset manual(Datatype::DOUBLE, {1000});
+        manual.setChunkSize({100});
+        e["positionOffset"]["x"].resetDataset(manual);
+        BOOST_TEST(e["position"]["x"].getChunkSize().empty());
+
+        std::shared_ptr< double > x(new double[1000](), [](double* p){ delete[] p; });
+        e["position"]["x"].storeChunk({0}, {1000}, x);
+        e["positionOffset"]["x"].storeChunk({0}, {1000}, x);
+        o.flush();
+        BOOST_TEST(e["position"]["x"].getChunkSize() == Extent({125}));
+    }
+
+    Series i = Series::read("samples",
+                            "serial_chunk_size.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+    BOOST_TEST(e["position"]["x"].getChunkSize() == Extent({125}));
+    BOOST_TEST(e["positionOffset"]["x"].getChunkSize() == Extent({100}));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_layout_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_layout.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        std::shared_ptr< double > x(new double[64], [](double* p){ delete[] p; });
+        for( int i = 0; i < 64; ++i )
+            x.get()[i] = i;
+        e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {64}));
+        e["position"]["x"].storeChunk({0}, {32}, x);
+        e["position"]["x"].storeChunk({32}, {32}, std::shared_ptr< double >(x, x.get() + 32));
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {64}).setLayout(Dataset::Layout::COMPACT));
+        e["positionOffset"]["x"].storeChunk({0}, {64}, x);
+        /* too large to be stored with the metadata of the dataset */
+        BOOST_CHECK_THROW(e["momentum"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {64 * 1024}).setLayout(Dataset::Layout::COMPACT)),
+                          std::runtime_error);
+        e["momentum"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {64}).setChunkSize({16}));
+        e["momentum"]["x"].storeChunk({0}, {64}, x);
+        o.flush();
+        BOOST_TEST((e["position"]["x"].getLayout() == Dataset::Layout::CONTIGUOUS));
+        BOOST_TEST(e["position"]["x"].getChunkSize().empty());
+
+    }
+
+    Series i = Series::read("samples",
+                            "serial_layout.h5");
+    ParticleSpecies& e = i.iterations[1].particles["e"];
+    BOOST_TEST((e["position"]["x"].getLayout() == Dataset::Layout::CONTIGUOUS));
+    BOOST_TEST((e["positionOffset"]["x"].getLayout() == Dataset::Layout::COMPACT));
+    BOOST_TEST((e["momentum"]["x"].getLayout() == Dataset::Layout::CHUNKED));
+    BOOST_TEST(e["momentum"]["x"].getChunkSize() == Extent({16}));
+
+    for( auto const& name : {"position", "positionOffset", "momentum"} )
+    {
+        std::unique_ptr< double[] > x;
+        e[name]["x"].loadChunk({0}, {64}, x, RecordComponent::Allocation::API);
+        BOOST_TEST(x[0] == 0.);
+        BOOST_TEST(x[63] == 63.);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_file_tuning_test)
+{
+    FileTuning tuning;
+    tuning.alignment = 4096;
+    tuning.alignmentThreshold = 1024;
+    tuning.metaBlockSize = 64 * 1024;
+    tuning.pageSize = 64 * 1024;
+    tuning.metadataCacheSize = 4 * 1024 * 1024;
+    tuning.formatVersion = FileTuning::FormatVersion::V18;
+    {
+        Series o = Series::create("samples",
+                                  "serial_file_tuning.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+        o.setFileTuning(tuning);
+
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        Dataset d(Datatype::DOUBLE, {1024});
+        d.setFillTime(Dataset::FillTime::NEVER)
+         .setAllocationTime(Dataset::AllocationTime::EARLY);
+        e["position"]["x"].resetDataset(d);
+        std::shared_ptr< double > x(new double[1024], [](double* p){ delete[] p; });
+        for( int i = 0; i < 1024; ++i )
+            x.get()[i] = i;
+        e["position"]["x"].storeChunk({0}, {1024}, x);
+    }
+
+    /* creation properties are persistent, the access properties apply to the open file only */
+    hid_t file = H5Fopen("samples/serial_file_tuning.h5", H5F_ACC_RDONLY, H5P_DEFAULT);
+    BOOST_REQUIRE(file >= 0);
+    hid_t fileCreation = H5Fget_create_plist(file);
+    hsize_t pageSize = 0;
+    H5Pget_file_space_page_size(fileCreation, &pageSize);
+    BOOST_TEST(pageSize == tuning.pageSize);
+    H5Pclose(fileCreation);
+    hid_t dataset = H5Dopen(file, "/data/1/particles/e/position/x", H5P_DEFAULT);
+    BOOST_REQUIRE(dataset >= 0);
+    hid_t datasetCreation = H5Dget_create_plist(dataset);
+    H5D_fill_time_t fillTime;
+    H5D_alloc_time_t allocTime;
+    H5Pget_fill_time(datasetCreation, &fillTime);
+    H5Pget_alloc_time(datasetCreation, &allocTime);
+    BOOST_TEST(fillTime == H5D_FILL_TIME_NEVER);
+    BOOST_TEST(allocTime == H5D_ALLOC_TIME_EARLY);
+    H5Pclose(datasetCreation);
+    H5Dclose(dataset);
+    H5Fclose(file);
+
+    Series i = Series::read("samples",
+                            "serial_file_tuning.h5");
+    std::unique_ptr< double[] > x;
+    i.iterations[1].particles["e"]["position"]["x"].loadChunk({0}, {1024}, x, RecordComponent::Allocation::API);
+    BOOST_TEST(x[1023] == 1023.);
+
+    tuning.alignment = 0;
+    BOOST_CHECK_THROW(i.setFileTuning(tuning), std::runtime_error);
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_compression_threads_test)
+{
+    std::vector< double > values(20 * 12);
+    for( size_t i = 0; i < values.size(); ++i )
+        values[i] = 0.25 * static_cast< double >(i % 37);
+
+    {
+        Series o = Series::create("samples",
+                                  "serial_compression_threads.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+        o.setCompressionThreads(4);
+
+        /* the last row of chunks only partially lies inside the dataset */
+        Mesh& rho = o.iterations[1].meshes["rho"];
+        rho.setAxisLabels({"x", "y"});
+        rho.setGridSpacing(std::vector< double >{1, 1});
+        rho.setGridGlobalOffset(std::vector< double >{0, 0});
+        Dataset d(Datatype::DOUBLE, {20, 12});
+        d.setChunkSize({8, 6});
+        d.addFilter(Dataset::Filter::shuffle())
+         .addFilter(Dataset::Filter::deflate(4))
+         .addFilter(Dataset::Filter::fletcher32());
+        MeshRecordComponent& r = rho[MeshRecordComponent::SCALAR];
+        r.setPosition(std::vector< double >{0, 0});
+        r.resetDataset(d);
+        std::shared_ptr< double > data(values.data(), [](double*){ });
+        r.storeChunk({0, 0}, {20, 12}, data);
+        o.flush();
+    }
+
+    /* a single thread filters the six chunks in two batches */
+    for( unsigned int threads : {0u, 3u, 1u} )
+    {
+        Series i = Series::read("samples",
+                                "serial_compression_threads.h5");
+        /* the workers are replaced when their number changes */
+        i.setCompressionThreads(2);
+        i.setCompressionThreads(threads);
+        MeshRecordComponent& rho = i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR];
+
+        std::unique_ptr< double[] > all;
+        rho.loadChunk({0, 0}, {20, 12}, all, RecordComponent::Allocation::API);
+        for( size_t k = 0; k < values.size(); ++k )
+            BOOST_REQUIRE(all[k] == values[k]);
+
+        /* regions not aligned to storage chunks are filtered by HDF5 */
+        std::unique_ptr< double[] > part;
+        rho.loadChunk({3, 5}, {2, 2}, part, RecordComponent::Allocation::API);
+        BOOST_TEST(part[0] == values[3 * 12 + 5]);
+        BOOST_TEST(part[3] == values[4 * 12 + 6]);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_async_write_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_async_write.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE,
+                                  true);
+
+        o.setAuthor("Serial HDF5");
+        o.iterations[1].setAttribute("custom", std::vector< int32_t >{4, 2});
+        ParticleSpecies& e = o.iterations[1].particles["e"];
+        e["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {4}));
+        e["positionOffset"]["x"].resetDataset(Dataset(Datatype::UINT64, {4}));
+
+        std::vector< std::future< void > > pending;
+        for( uint64_t i = 0; i < 4; ++i )
+        {
+            /* buffers handed to an asynchronous flush must not be reused before its completion,
+             * the series itself may be modified while previous flushes are pending */
+            std::shared_ptr< double > position_local(new double(static_cast< double >(i)));
+            std::shared_ptr< uint64_t > positionOffset_local(new uint64_t(i));
+            e["position"]["x"].storeChunk({i}, {1}, position_local);
+            e["positionOffset"]["x"].storeChunk({i}, {1}, positionOffset_local);
+            o.iterations[1].setTime(static_cast< double >(i));
+            pending.push_back(o.flush());
+        }
+
+        for( auto& f : pending )
+        {
+            BOOST_TEST(f.valid());
+            f.get();
+        }
+    }
+
+    Series i = Series::read("samples",
+                            "serial_async_write.h5");
+    BOOST_TEST(i.author() == "Serial HDF5");
+    BOOST_TEST(i.iterations[1].getAttribute("custom").get< std::vector< int32_t > >() == std::vector< int32_t >({4, 2}));
+    BOOST_TEST(i.iterations[1].time< double >() == 3.);
+
+    std::unique_ptr< double[] > position;
+    i.iterations[1].particles["e"]["position"]["x"].loadChunk({0}, {4}, position, RecordComponent::Allocation::API);
+    std::unique_ptr< uint64_t[] > positionOffset;
+    i.iterations[1].particles["e"]["positionOffset"]["x"].loadChunk({0}, {4}, positionOffset, RecordComponent::Allocation::API);
+    for( uint64_t j = 0; j < 4; ++j )
+    {
+        BOOST_TEST(position[j] == static_cast< double >(j));
+        BOOST_TEST(positionOffset[j] == j);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_coalesced_write_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_coalesced_write.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+
+        Mesh& E = o.iterations[1].meshes["E"];
+        E.setGridSpacing(std::vector< double >{1, 1});
+        E.setGridGlobalOffset(std::vector< double >{0, 0});
+        E.setAxisLabels({"x", "y"});
+        MeshRecordComponent& Ex = E["x"];
+        Ex.setPosition(std::vector< double >{0, 0});
+        Ex.resetDataset(Dataset(Datatype::INT32, {4, 6}));
+
+        /* two rows merging along the first dimension */
+        for( uint64_t row = 0; row < 2; ++row )
+        {
+            std::shared_ptr< int32_t > data(new int32_t[6], [](int32_t* p){ delete[] p; });
+            for( int32_t j = 0; j < 6; ++j )
+                data.get()[j] = static_cast< int32_t >(row) * 6 + j;
+            Ex.storeChunk({row, 0}, {1, 6}, data);
+        }
+        /* two blocks merging along the second dimension */
+        for( uint64_t col = 0; col < 6; col += 3 )
+        {
+            std::shared_ptr< int32_t > data(new int32_t[6], [](int32_t* p){ delete[] p; });
+            for( int32_t i = 0; i < 2; ++i )
+                for( int32_t j = 0; j < 3; ++j )
+                    data.get()[i * 3 + j] = (2 + i) * 6 + static_cast< int32_t >(col) + j;
+            Ex.storeChunk({2, col}, {2, 3}, data);
+        }
+
+        Mesh& rho = o.iterations[1].meshes["rho"];
+        rho.setGridSpacing(std::vector< double >{1, 1});
+        rho.setGridGlobalOffset(std::vector< double >{0, 0});
+        rho.setAxisLabels({"x", "y"});
+        MeshRecordComponent& r = rho[MeshRecordComponent::SCALAR];
+        r.setPosition(std::vector< double >{0, 0});
+        r.resetDataset(Dataset(Datatype::INT32, {1, 6}));
+
+        /* overlapping chunks, the later one takes precedence */
+        std::shared_ptr< int32_t > first(new int32_t[4], [](int32_t* p){ delete[] p; });
+        std::shared_ptr< int32_t > second(new int32_t[4], [](int32_t* p){ delete[] p; });
+        for( int32_t j = 0; j < 4; ++j )
+        {
+            first.get()[j] = j;
+            second.get()[j] = 100 + j;
+        }
+        r.storeChunk({0, 0}, {1, 4}, first);
+        r.storeChunk({0, 2}, {1, 4}, second);
+
+        o.flush();
+    }
+
+    Series i = Series::read("samples",
+                            "serial_coalesced_write.h5");
+
+    std::unique_ptr< int32_t[] > E;
+    i.iterations[1].meshes["E"]["x"].loadChunk({0, 0}, {4, 6}, E, RecordComponent::Allocation::API);
+    for( int32_t j = 0; j < 24; ++j )
+        BOOST_TEST(E[j] == j);
+
+    std::unique_ptr< int32_t[] > rho;
+    i.iterations[1].meshes["rho"][MeshRecordComponent::SCALAR].loadChunk({0, 0}, {1, 6}, rho, RecordComponent::Allocation::API);
+    int32_t expected[6] = {0, 1, 100, 101, 102, 103};
+    for( int j = 0; j < 6; ++j )
+        BOOST_TEST(rho[j] == expected[j]);
+}
+
 BOOST_AUTO_TEST_CASE(hdf5_fileBased_write_test)
 {
     Series o = Series::create("samples",
@@ -887,6 +1594,279 @@ BOOST_AUTO_TEST_CASE(hdf5_fileBased_write_test)
     //TODO close file, read back, verify
 }
 
+BOOST_AUTO_TEST_CASE(hdf5_lazy_read_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_lazy_read%T",
+                                  IterationEncoding::fileBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+
+        for( uint64_t i = 1; i <= 3; ++i )
+        {
+            o.iterations[i].setTime(static_cast< double >(10 * i));
+            RecordComponent& x = o.iterations[i].particles["e"]["position"]["x"];
+            x.resetDataset(Dataset(Datatype::DOUBLE, {4}));
+            x.storeChunk({0}, {4}, std::shared_ptr< double >(new double[4]{1. * i, 2. * i, 3. * i, 4. * i}, [](double* p){ delete[] p; }));
+        }
+        o.flush();
+    }
+
+    ReadOptions lazy;
+    lazy.lazy = true;
+    Series i = Series::read("samples",
+                            "serial_lazy_read%T.h5",
+                            lazy);
+    BOOST_TEST(i.iterations.size() == 3);
+    BOOST_TEST(i.iterations.count(1) == 1);
+    BOOST_TEST(i.iterations.count(2) == 1);
+    BOOST_TEST(i.iterations.count(3) == 1);
+
+    /* only the accessed iteration is parsed */
+    Iteration& it = i.iterations[2];
+    BOOST_TEST(it.time< double >() == 20.);
+    BOOST_TEST(it.particles.size() == 1);
+    BOOST_TEST(i.iterations.find(3)->second.time< double >() == 30.);
+
+    std::unique_ptr< double[] > position;
+    it.particles["e"]["position"]["x"].loadChunk({0}, {4}, position, RecordComponent::Allocation::API);
+    for( uint64_t j = 0; j < 4; ++j )
+        BOOST_TEST(position[j] == 2. * (j + 1));
+
+    /* iterating reads the iterations that have not been accessed yet */
+    for( auto& entry : i.iterations )
+    {
+        BOOST_TEST(entry.second.time< double >() == 10. * entry.first);
+        BOOST_TEST(entry.second.particles.size() == 1);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_indexed_read_test)
+{
+    auto write = [](uint64_t first, uint64_t last)
+    {
+        Series o = Series::create("samples",
+                                  "serial_indexed_read%T",
+                                  IterationEncoding::fileBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+        for( uint64_t i = first; i <= last; ++i )
+            o.iterations[i].setTime(static_cast< double >(i));
+    };
+
+    /* files of previous runs would be part of the series */
+    std::remove("samples/serial_indexed_read3.h5");
+    std::remove("samples/.serial_indexed_read%T.index");
+    write(1, 2);
+    /* modifications within the second of the scan would make the index untrusted */
+    std::time_t past = boost::filesystem::last_write_time("samples") - 10;
+    boost::filesystem::last_write_time("samples", past);
+    ReadOptions indexed;
+    indexed.lazy = true;
+    indexed.indexed = true;
+    {
+        Series i = Series::read("samples",
+                                "serial_indexed_read%T.h5",
+                                indexed);
+        BOOST_TEST(i.iterations.size() == 2);
+    }
+    /* a readonly series does not write the index */
+    BOOST_TEST(!std::ifstream("samples/.serial_indexed_read%T.index").good());
+    BOOST_TEST(boost::filesystem::last_write_time("samples") == past);
+
+    /* creating the index modifies the directory, the index of this scan is not trusted */
+    {
+        Series i = Series::read("samples",
+                                "serial_indexed_read%T.h5",
+                                indexed,
+                                false);
+        BOOST_TEST(i.iterations.size() == 2);
+        BOOST_TEST(i.iterations[2].time< double >() == 2.);
+    }
+    BOOST_TEST(std::ifstream("samples/.serial_indexed_read%T.index").good());
+    boost::filesystem::last_write_time("samples", past);
+    /* overwriting the existing index leaves the directory untouched */
+    {
+        Series i = Series::read("samples",
+                                "serial_indexed_read%T.h5",
+                                indexed,
+                                false);
+        BOOST_TEST(i.iterations.size() == 2);
+    }
+    BOOST_TEST(boost::filesystem::last_write_time("samples") == past);
+
+    /* a valid index is used by readonly series as well, a new file hidden from the directory time is not seen */
+    write(3, 3);
+    boost::filesystem::last_write_time("samples", past);
+    {
+        Series i = Series::read("samples",
+                                "serial_indexed_read%T.h5",
+                                indexed);
+        BOOST_TEST(i.iterations.size() == 2);
+    }
+
+    /* a stale index must not hide new files */
+    boost::filesystem::last_write_time("samples", past + 1);
+    Series i = Series::read("samples",
+                            "serial_indexed_read%T.h5",
+                            indexed);
+    BOOST_TEST(i.iterations.size() == 3);
+    BOOST_TEST(i.iterations[3].time< double >() == 3.);
+
+    ReadOptions prefetch;
+    prefetch.prefetch = true;
+    Series p = Series::read("samples",
+                            "serial_indexed_read%T.h5",
+                            prefetch);
+    BOOST_TEST(p.iterations.size() == 3);
+    for( uint64_t j = 1; j <= 3; ++j )
+        BOOST_TEST(p.iterations[j].time< double >() == static_cast< double >(j));
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_file_pool_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_file_pool%T",
+                                  IterationEncoding::fileBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+        o.setMaxOpenFiles(2);
+
+        for( uint64_t i = 1; i <= 4; ++i )
+        {
+            RecordComponent& x = o.iterations[i].particles["e"]["position"]["x"];
+            x.resetDataset(Dataset(Datatype::DOUBLE, {2}));
+            x.storeChunk({0}, {2}, std::shared_ptr< double >(new double[2]{1. * i, 2. * i}, [](double* p){ delete[] p; }));
+            o.flush();
+        }
+        o.iterations[1].close();
+
+        /* closed iterations are re-opened on access */
+        o.iterations[1].setAttribute("reopened", 1);
+
+        /* changes through a reference retained before closing are written as well */
+        Iteration& last = o.iterations[4];
+        RecordComponent& x = last.particles["e"]["position"]["x"];
+        last.close();
+        last.setAttribute("retained", 4);
+        x.storeChunk({1}, {1}, std::shared_ptr< double >(new double(-4.)));
+        o.flush();
+    }
+
+    Series i = Series::read("samples",
+                            "serial_file_pool%T.h5");
+    i.setMaxOpenFiles(1);
+    BOOST_TEST(i.iterations.size() == 4);
+    BOOST_TEST(i.iterations[1].getAttribute("reopened").get< int >() == 1);
+    BOOST_TEST(i.iterations[4].getAttribute("retained").get< int >() == 4);
+    for( uint64_t j : {4, 1, 3, 2, 1} )
+    {
+        std::unique_ptr< double[] > position;
+        i.iterations[j].particles["e"]["position"]["x"].loadChunk({0}, {2}, position, RecordComponent::Allocation::API);
+        BOOST_TEST(position[0] == 1. * j);
+        BOOST_TEST(position[1] == (j == 4 ? -4. : 2. * j));
+        i.iterations[j].close();
+    }
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_unmodified_iterations_test)
+{
+    Series o = Series::create("samples",
+                              "serial_unmodified%T",
+                              IterationEncoding::fileBased,
+                              Format::HDF5,
+                              AccessType::CREATE);
+    o.setMaxOpenFiles(1);
+
+    for( uint64_t i = 1; i <= 3; ++i )
+    {
+        o.iterations[i].setTime(static_cast< double >(i));
+        o.flush();
+    }
+
+    /* a flush must not touch the files of unmodified iterations */
+    BOOST_TEST(std::remove("samples/serial_unmodified1.h5") == 0);
+    o.iterations[3].setAttribute("modified", 1);
+    o.flush();
+    o.iterations[4].setTime(4.);
+    o.flush();
+}
+
+BOOST_AUTO_TEST_CASE(hdf5_dirty_subtree_test)
+{
+    {
+        Series o = Series::create("samples",
+                                  "serial_dirty_subtree.h5",
+                                  IterationEncoding::groupBased,
+                                  Format::HDF5,
+                                  AccessType::CREATE);
+
+        Iteration& it = o.iterations[1];
+        for( char const* name : {"E", "rho"} )
+        {
+            Mesh& m = it.meshes[name];
+            m.setGridSpacing(std::vector< double >{1, 1});
+            m.setGridGlobalOffset(std::vector< double >{0, 0});
+            m.setAxisLabels({"x", "y"});
+        }
+        Mesh& E = it.meshes["E"];
+        Mesh& rho = it.meshes["rho"];
+        for( MeshRecordComponent* c : {&E["x"], &E["y"], &rho[RecordComponent::SCALAR]} )
+        {
+            c->setPosition(std::vector< double >{0, 0});
+            c->resetDataset(Dataset(Datatype::DOUBLE, {1, 2}));
+        }
+        it.particles["e"]["position"]["x"].resetDataset(Dataset(Datatype::DOUBLE, {2}));
+        o.flush();
+
+        BOOST_TEST(!it.dirtyRecursive);
+        BOOST_TEST(!it.meshes.dirtyRecursive);
+        BOOST_TEST(!E.dirtyRecursive);
+        BOOST_TEST(!E["x"].dirtyRecursive);
+
+        /* a stored chunk only marks the branch it belongs to */
+        std::shared_ptr< double > data(new double[2]{1., 2.}, [](double* p){ delete[] p; });
+        E["x"].storeChunk({0, 0}, {1, 2}, data);
+        BOOST_TEST(E["x"].dirtyRecursive);
+        BOOST_TEST(E.dirtyRecursive);
+        BOOST_TEST(it.meshes.dirtyRecursive);
+        BOOST_TEST(it.dirtyRecursive);
+        BOOST_TEST(!E["y"].dirtyRecursive);
+        BOOST_TEST(!it.particles.dirtyRecursive);
+        o.flush();
+        BOOST_TEST(!E["x"].dirtyRecursive);
+
+        /* scalar components are attached to the parent of their record */
+        rho[RecordComponent::SCALAR].setUnitSI(42.);
+        BOOST_TEST(rho.isDirtyRecursive());
+        BOOST_TEST(!E.isDirtyRecursive());
+        o.flush();
+        BOOST_TEST(!rho.isDirtyRecursive());
+    }
+
+    Series i = Series::read("samples",
+                            "serial_dirty_subtree.h5",
+                            false);
+    /* objects created while reading hold no changes */
+    BOOST_TEST(!i.dirtyRecursive);
+    BOOST_TEST(!i.iterations.dirtyRecursive);
+    BOOST_TEST(!i.iterations[1].dirtyRecursive);
+    BOOST_TEST(!i.iterations[1].meshes.dirtyRecursive);
+    BOOST_TEST(!i.iterations[1].meshes["E"].dirtyRecursive);
+    BOOST_TEST(!i.iterations[1].meshes["E"]["x"].dirtyRecursive);
+    BOOST_TEST(!i.iterations[1].meshes["rho"].isDirtyRecursive());
+    BOOST_TEST(!i.iterations[1].particles["e"].dirtyRecursive);
+    BOOST_TEST(!i.iterations[1].particles["e"].particlePatches.dirtyRecursive);
+    BOOST_TEST(!i.iterations[1].particles["e"]["position"]["x"].dirtyRecursive);
+    std::unique_ptr< double[] > x;
+    i.iterations[1].meshes["E"]["x"].loadChunk({0, 0}, {1, 2}, x, RecordComponent::Allocation::API);
+    BOOST_TEST(x[0] == 1.);
+    BOOST_TEST(x[1] == 2.);
+    BOOST_TEST(i.iterations[1].meshes["rho"][RecordComponent::SCALAR].unitSI() == 42.);
+}
+
 BOOST_AUTO_TEST_CASE(hdf5_bool_test)
 {
     Series o = Series::create("samples",